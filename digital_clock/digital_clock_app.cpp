@@ -9,30 +9,38 @@
 #include <stm32wbxx_ll_rtc.h>
 
 #include <furi/core/event_loop.h>
+#include <furi/core/log.h>
 #include <furi_hal_bus.h>
 #include <furi_hal_interrupt.h>
 
+#include <algorithm>
+#include <chrono>
+
 using namespace cookie;
 
+#define TAG "DigitalClock"
+
 #define TICK_TOCK_TIMER LPTIM2
 static constexpr auto TICK_TOCK_TIMER_BUS = FuriHalBusLPTIM2;
 static constexpr auto TICK_TOCK_TIMER_INTERRUPT = FuriHalInterruptIdLpTim2;
 static constexpr auto TICK_TOCK_TIMER_IRQ = LPTIM2_IRQn;
-static constexpr uint32_t TICK_TOCK_TIMER_FREQ = 32768u;
+static constexpr uint32_t TICK_TOCK_TIMER_PRESCALER = 128; // Ticks at 256Hz off the LSE
+// Fire this many ticks past every boundary, so the RTC is sampled after it has ticked over
+static constexpr uint32_t TICK_TOCK_TIMER_MARGIN = 1;
+
+// The backlight state can't be queried, so assume it goes off after the firmware's default
+// timeout without input. The blinking colon isn't visible past that.
+static const uint32_t BACKLIGHT_TIMEOUT_TICKS =
+    furi_chrono_duration_to_ticks(std::chrono::seconds(30));
+// Nobody is looking at the seconds either after a while, so only wake up once a minute
+static const uint32_t DEEP_IDLE_TIMEOUT_TICKS =
+    furi_chrono_duration_to_ticks(std::chrono::minutes(5));
 
 DigitalClockApp::DigitalClockApp()
     // TODO: This will be easier once View Dispatchers can adopt event loops
-    : m_clock_view(view_dispatcher_get_event_loop(*m_view_dispatcher)) {
-    furi_event_loop_subscribe_semaphore(
-        view_dispatcher_get_event_loop(*m_view_dispatcher),
-        *m_tick_tock_semaphore,
-        FuriEventLoopEventIn,
-        [](void* object, void* context) {
-            DigitalClockApp* app = reinterpret_cast<DigitalClockApp*>(context);
-            app->SendAppEvent(AppLogicEvent::TickTock);
-            furi_semaphore_acquire(reinterpret_cast<::FuriSemaphore*>(object), FuriWaitForever);
-        },
-        this);
+    : m_clock_view(view_dispatcher_get_event_loop(*m_view_dispatcher))
+    , PREDIV_A(LL_RTC_GetAsynchPrescaler(RTC))
+    , PREDIV_S(LL_RTC_GetSynchPrescaler(RTC)) {
 
     view_dispatcher_install_scene_manager<
         ViewDispatcherInstallOptions::Back | ViewDispatcherInstallOptions::Custom>(
@@ -50,15 +58,18 @@ DigitalClockApp::DigitalClockApp()
             LL_LPTIM_ClearFlag_ARRM(TICK_TOCK_TIMER);
 
             DigitalClockApp* app = reinterpret_cast<DigitalClockApp*>(context);
-            furi_semaphore_release(*app->m_tick_tock_semaphore);
+            const RtcTimestamp timestamp = DigitalClockView::SampleRtc();
+            app->m_tick_tock_ring.push(timestamp);
+            app->m_tick_tock_wakeups.fetch_add(1, std::memory_order_relaxed);
+
+            // ARRM fires when the counter reaches the autoreload value, one count before it
+            // reloads. The update mode defers this write to that reload, which leaves the
+            // pending count for the next period to account for.
+            LL_LPTIM_SetAutoReload(TICK_TOCK_TIMER, app->GetTickTockAutoReload(timestamp, 1));
         },
         this);
 
     LL_RCC_SetLPTIMClockSource(LL_RCC_LPTIM2_CLKSOURCE_LSE);
-
-    LL_LPTIM_InitTypeDef tickTockTimerDef{};
-    tickTockTimerDef.Prescaler = LL_LPTIM_PRESCALER_DIV128;
-    LL_LPTIM_Init(TICK_TOCK_TIMER, &tickTockTimerDef);
 }
 
 DigitalClockApp::~DigitalClockApp() {
@@ -69,9 +80,6 @@ DigitalClockApp::~DigitalClockApp() {
 
     view_dispatcher_remove_view(*m_view_dispatcher, furi_enum_param(AppView::Clock));
     view_dispatcher_remove_view(*m_view_dispatcher, furi_enum_param(AppView::Init));
-
-    furi_event_loop_unsubscribe(
-        view_dispatcher_get_event_loop(*m_view_dispatcher), *m_tick_tock_semaphore);
 }
 
 void DigitalClockApp::Run() {
@@ -105,15 +113,15 @@ void DigitalClockApp::StartTickTockTimer() {
     if(m_tick_tock_timer_running) {
         return;
     }
+    // Always start at the full rate, the idle task steps it down
+    SetTickRate(TickRate::HalfSecond);
     m_tick_tock_timer_running = true;
 
-    LL_LPTIM_Enable(TICK_TOCK_TIMER);
-    while(!LL_LPTIM_IsEnabled(TICK_TOCK_TIMER))
-        ;
+    m_tick_tock_wakeups.store(0, std::memory_order_relaxed);
+    m_tick_tock_start_tick = furi_get_tick();
 
-    LL_LPTIM_EnableIT_ARRM(TICK_TOCK_TIMER);
-    LL_LPTIM_SetAutoReload(TICK_TOCK_TIMER, 127); // Autoreload twice a second
-    LL_LPTIM_StartCounter(TICK_TOCK_TIMER, LL_LPTIM_OPERATING_MODE_CONTINUOUS);
+    ArmTickTockTimer();
+    m_idle_task = ProcessIdleAsync();
 }
 
 void DigitalClockApp::StopTickTockTimer() {
@@ -122,10 +130,120 @@ void DigitalClockApp::StopTickTockTimer() {
     }
     m_tick_tock_timer_running = false;
 
+    m_idle_task.reset();
+    DisarmTickTockTimer();
+
+    FURI_LOG_I(
+        TAG,
+        "Tick-tock wakeups: %lu, %lu per hour",
+        m_tick_tock_wakeups.load(std::memory_order_relaxed),
+        GetTickTockWakeupsPerHour());
+}
+
+void DigitalClockApp::OnUserActivity() {
+    if(!m_tick_tock_timer_running) {
+        return;
+    }
+
+    SetTickRate(TickRate::HalfSecond);
+    m_idle_task = ProcessIdleAsync();
+}
+
+uint32_t DigitalClockApp::GetTickTockWakeupsPerHour() const {
+    const uint32_t elapsed_ticks = furi_get_tick() - m_tick_tock_start_tick;
+    if(elapsed_ticks == 0) {
+        return 0;
+    }
+
+    const uint64_t ticks_per_hour = uint64_t(furi_kernel_get_tick_frequency()) * 60 * 60;
+    return (m_tick_tock_wakeups.load(std::memory_order_relaxed) * ticks_per_hour) / elapsed_ticks;
+}
+
+void DigitalClockApp::SetTickRate(TickRate rate) {
+    if(m_tick_rate.load(std::memory_order_relaxed) == rate) {
+        return;
+    }
+    m_tick_rate.store(rate, std::memory_order_relaxed);
+    m_clock_view.SetTickRate(rate);
+
+    // Realign right away, a slower rate may otherwise skip the next boundary of the faster one
+    // and a faster rate would only kick in after the slow period elapses
+    if(m_tick_tock_timer_running) {
+        DisarmTickTockTimer();
+        ArmTickTockTimer();
+    }
+}
+
+uint32_t DigitalClockApp::GetTickTockAutoReload(
+    const RtcTimestamp& timestamp, uint32_t pending_ticks) const {
+    // The subsecond register counts down from PREDIV_S, at the LSE frequency / (PREDIV_A + 1)
+    const uint32_t subsecond_ticks = PREDIV_S + 1;
+    const uint32_t elapsed = PREDIV_S - timestamp.subsecond;
+
+    uint32_t remaining;
+    switch(m_tick_rate.load(std::memory_order_relaxed)) {
+    case TickRate::HalfSecond:
+        remaining = (subsecond_ticks / 2) - (elapsed % (subsecond_ticks / 2));
+        break;
+    case TickRate::Second:
+        remaining = subsecond_ticks - elapsed;
+        break;
+    case TickRate::Minute: {
+        const uint32_t second = __LL_RTC_CONVERT_BCD2BIN(__LL_RTC_GET_SECOND(timestamp.time));
+        remaining = ((59 - second) * subsecond_ticks) + (subsecond_ticks - elapsed);
+        break;
+    }
+    }
+
+    // Convert to the timer ticks. The counter matches the autoreload value that many counts
+    // after restarting from 0, which happens after the pending counts.
+    // The register is only 16-bit wide, and must stay above the (unused) compare register.
+    const uint32_t ticks = (remaining * (PREDIV_A + 1)) / TICK_TOCK_TIMER_PRESCALER;
+    return std::clamp<uint32_t>(
+               ticks + TICK_TOCK_TIMER_MARGIN, pending_ticks + 1, pending_ticks + 0xFFFF) -
+           pending_ticks;
+}
+
+void DigitalClockApp::ArmTickTockTimer() {
+    // Initialize on every arm, disarming resets the peripheral
+    LL_LPTIM_InitTypeDef tickTockTimerDef{};
+    tickTockTimerDef.Prescaler = LL_LPTIM_PRESCALER_DIV128;
+    LL_LPTIM_Init(TICK_TOCK_TIMER, &tickTockTimerDef);
+    // Autoreload writes from the ISR must not land mid-period, where the counter would run on
+    // from the old value instead of restarting. Only configurable while the timer is disabled.
+    LL_LPTIM_SetUpdateMode(TICK_TOCK_TIMER, LL_LPTIM_UPDATE_MODE_ENDOFPERIOD);
+
+    LL_LPTIM_Enable(TICK_TOCK_TIMER);
+    while(!LL_LPTIM_IsEnabled(TICK_TOCK_TIMER))
+        ;
+
+    LL_LPTIM_EnableIT_ARRM(TICK_TOCK_TIMER);
+    // The counter starts from 0, so nothing is pending
+    LL_LPTIM_SetAutoReload(
+        TICK_TOCK_TIMER, GetTickTockAutoReload(DigitalClockView::SampleRtc(), 0));
+    LL_LPTIM_StartCounter(TICK_TOCK_TIMER, LL_LPTIM_OPERATING_MODE_CONTINUOUS);
+}
+
+void DigitalClockApp::DisarmTickTockTimer() {
     furi_hal_bus_reset(TICK_TOCK_TIMER_BUS);
     NVIC_ClearPendingIRQ(TICK_TOCK_TIMER_IRQ);
 }
 
+cookie::Task<> DigitalClockApp::ProcessIdleAsync() {
+    co_await m_idle_timer.await_delay(BACKLIGHT_TIMEOUT_TICKS);
+    SetTickRate(TickRate::Second);
+
+    co_await m_idle_timer.await_delay(DEEP_IDLE_TIMEOUT_TICKS - BACKLIGHT_TIMEOUT_TICKS);
+    SetTickRate(TickRate::Minute);
+}
+
+void DigitalClockApp::OnTickTock(
+    const RtcTimestamp* timestamps, std::size_t count, void* context) {
+    // If the loop fell behind, only the newest timestamp is worth displaying
+    DigitalClockApp* app = reinterpret_cast<DigitalClockApp*>(context);
+    app->m_clock_view.OnTimeUpdate(timestamps[count - 1]);
+}
+
 ::FuriEventLoop* DigitalClockApp::GetEventLoop() const {
     return view_dispatcher_get_event_loop(*m_view_dispatcher);
 }
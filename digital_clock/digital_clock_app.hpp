@@ -1,7 +1,11 @@
 #pragma once
 
-#include <cookie/semaphore>
+#include <atomic>
+
+#include <cookie/coroutine>
+#include <cookie/spsc_ring>
 #include <cookie/thread>
+#include <cookie/timer>
 #include <cookie/within>
 #include <cookie/gui/gui>
 #include <cookie/gui/scene_manager>
@@ -21,7 +25,6 @@ enum class AppView {
 enum class AppLogicEvent {
     GoToNextScene,
     ExitRequested,
-    TickTock,
 };
 
 class DigitalClockApp : cookie::EnableWithin<DigitalClockApp> {
@@ -40,8 +43,25 @@ public:
     void StartTickTockTimer();
     void StopTickTockTimer();
 
+    // Any input restores the full tick rate, which then steps down again while idle
+    void OnUserActivity();
+    // Averaged since the tick-tock timer was started
+    uint32_t GetTickTockWakeupsPerHour() const;
+
     ::FuriEventLoop* GetEventLoop() const;
 
+private:
+    static void OnTickTock(const RtcTimestamp* timestamps, std::size_t count, void* context);
+
+    void SetTickRate(TickRate rate);
+    // pending_ticks are the counts left before the counter restarts from 0.
+    // Called from the ISR too, everything it reads must be safe to read there.
+    uint32_t GetTickTockAutoReload(const RtcTimestamp& timestamp, uint32_t pending_ticks) const;
+    void ArmTickTockTimer();
+    void DisarmTickTockTimer();
+
+    cookie::Task<> ProcessIdleAsync();
+
 private:
     cookie::Gui m_gui;
 
@@ -51,11 +71,23 @@ private:
     cookie::SceneManager m_scene_manager{scene_handlers, this};
 
     // We can't submit a custom view dispatcher event from the ISR, as that tries to block.
-    // Work it around by releasing a semaphore from the ISR, and putting a custom event in the queue this way instead.
-    // Can be removed once view_dispatcher_send_custom_event works from the ISR.
-    cookie::FuriBinarySemaphore m_tick_tock_semaphore;
+    // Instead, the ISR samples the RTC and queues the timestamp in a lock-free ring,
+    // which the event loop drains straight into the clock view.
+    cookie::EventLoopSpscRing<RtcTimestamp, 4> m_tick_tock_ring{GetEventLoop(), OnTickTock, this};
     bool m_tick_tock_timer_running = false;
 
+    // The timer is re-armed on every tick, aligned to the RTC subsecond counter,
+    // so the face always updates right after the displayed time changes
+    const uint32_t PREDIV_A;
+    const uint32_t PREDIV_S;
+    std::atomic<TickRate> m_tick_rate{TickRate::HalfSecond};
+
+    std::atomic<uint32_t> m_tick_tock_wakeups{0};
+    uint32_t m_tick_tock_start_tick = 0;
+
+    cookie::AwaitableTimer<cookie::FuriEventLoopTimer> m_idle_timer{GetEventLoop()};
+    cookie::Task<> m_idle_task;
+
 public:
     DEFINE_GET_FROM_INNER(m_init_view);
     DEFINE_GET_FROM_INNER(m_clock_view);
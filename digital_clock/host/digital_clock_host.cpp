@@ -0,0 +1,160 @@
+// Host harness of the digital clock's drawing code. Draws every frame below on the host canvas,
+// compares it pixel by pixel against its golden PBM image, and reports how many drawing calls
+// and how much time the frame takes. Run with --update to write the goldens instead,
+// after an intended change to the visuals.
+
+#include "seven_segment_display.hpp"
+#include "views/clock_face.hpp"
+
+#include <canvas_host.h>
+#include <gui/canvas.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+static constexpr uint32_t TIMED_ITERATIONS = 20000;
+
+struct Frame {
+    const char* name;
+    void (*draw)(Canvas* canvas);
+};
+
+template <ClockFace Face>
+static void draw_clock_face(Canvas* canvas) {
+    ClockFace::Draw(canvas, Face);
+}
+
+// Laid out like the splash screen
+template <typename Display = SevenSegmentDisplay>
+static void draw_centered_string(Canvas* canvas, const char* str) {
+    canvas_clear(canvas);
+    const uint32_t width = Display::MeasureString(str);
+    canvas_set_bitmap_mode(canvas, true);
+    Display::DrawString(canvas, str, (128 - width) / 2, (64 - Display::GetGlyphHeight()) / 2);
+    canvas_set_bitmap_mode(canvas, false);
+}
+
+// The width metrics have to agree with what actually gets drawn
+template <typename Display>
+static bool check_measurements() {
+    char str[2] = {};
+    for(char ch = ' '; ch <= '~'; ch++) {
+        str[0] = ch;
+        if(Display::MeasureString(str) != Display::DrawString(nullptr, str, 0, 0)) {
+            std::fprintf(stderr, "MeasureString('%c') doesn't match DrawString\n", ch);
+            return false;
+        }
+    }
+    return true;
+}
+
+static const Frame frames[] = {
+    {"clock_24h",
+     draw_clock_face<ClockFace{.hour = 13, .minute = 37, .second = 42, .show_colon = true}>},
+    {"clock_24h_colon_off", draw_clock_face<ClockFace{.hour = 13, .minute = 37, .second = 42}>},
+    {"clock_24h_midnight", draw_clock_face<ClockFace{.show_colon = true}>},
+    {"clock_12h_am",
+     draw_clock_face<ClockFace{
+         .hour = 9, .minute = 5, .second = 7, .show_colon = true, .twelve_hour_clock = true}>},
+    {"clock_12h_noon",
+     draw_clock_face<ClockFace{.hour = 12, .show_colon = true, .twelve_hour_clock = true}>},
+    {"clock_12h_pm",
+     draw_clock_face<ClockFace{
+         .hour = 23, .minute = 59, .second = 59, .show_colon = true, .twelve_hour_clock = true}>},
+    {"clock_24h_minute_rate",
+     draw_clock_face<ClockFace{
+         .hour = 13, .minute = 37, .show_colon = true, .tick_rate = TickRate::Minute}>},
+    {"clock_12h_minute_rate",
+     draw_clock_face<ClockFace{
+         .hour = 21,
+         .minute = 7,
+         .show_colon = true,
+         .twelve_hour_clock = true,
+         .tick_rate = TickRate::Minute}>},
+    {"clock_stats",
+     draw_clock_face<ClockFace{
+         .hour = 13,
+         .minute = 37,
+         .second = 42,
+         .show_colon = true,
+         .tick_rate = TickRate::Second,
+         .stats_shown = true,
+         .wakeups_per_hour = 3612}>},
+    {"lock_screen",
+     draw_clock_face<ClockFace{
+         .hour = 13, .minute = 37, .second = 42, .show_colon = true, .lock_screen_shown = true}>},
+    {"splash_flipper", [](Canvas* canvas) { draw_centered_string(canvas, "FLIPPER"); }},
+    {"splash_alarm", [](Canvas* canvas) { draw_centered_string(canvas, "ALARM"); }},
+    {"seven_segment_digits", [](Canvas* canvas) { draw_centered_string(canvas, "0123456"); }},
+    {"seven_segment_mixed", [](Canvas* canvas) { draw_centered_string(canvas, "89:Wm"); }},
+    {"seven_segment_small",
+     [](Canvas* canvas) {
+         draw_centered_string<SmallSevenSegmentDisplay>(canvas, "12:34:56 Wm");
+     }},
+};
+
+int main(int argc, char** argv) {
+    const bool update = argc > 1 && std::strcmp(argv[1], "--update") == 0;
+    if(argc > 2 || (argc == 2 && !update)) {
+        std::fprintf(stderr, "usage: %s [--update]\n", argv[0]);
+        return 2;
+    }
+
+    Canvas* canvas = canvas_host_alloc();
+    uint32_t failures = 0;
+
+    if(!check_measurements<SevenSegmentDisplay>() ||
+       !check_measurements<SmallSevenSegmentDisplay>()) {
+        failures++;
+    }
+
+    std::printf("%-24s %6s %8s %10s  %s\n", "frame", "calls", "pixels", "ns/frame", "golden");
+    for(const Frame& frame : frames) {
+        canvas_reset(canvas);
+        canvas_host_reset_statistics(canvas);
+        frame.draw(canvas);
+        const CanvasHostStatistics stats = canvas_host_get_statistics(canvas);
+
+        const std::string path = std::string(GOLDENS_DIR "/") + frame.name + ".pbm";
+        std::string result;
+        if(update) {
+            if(canvas_host_save_pbm(canvas, path.c_str())) {
+                result = "updated";
+            } else {
+                result = "FAILED TO WRITE";
+                failures++;
+            }
+        } else {
+            const int32_t mismatches = canvas_host_compare_pbm(canvas, path.c_str());
+            if(mismatches == 0) {
+                result = "ok";
+            } else if(mismatches < 0) {
+                result = "MISSING, run with --update";
+                failures++;
+            } else {
+                result = "MISMATCH, " + std::to_string(mismatches) + " pixels differ";
+                failures++;
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for(uint32_t i = 0; i < TIMED_ITERATIONS; i++) {
+            frame.draw(canvas);
+        }
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        std::printf(
+            "%-24s %6u %8u %10.0f  %s\n",
+            frame.name,
+            stats.draw_calls,
+            stats.pixels_drawn,
+            elapsed.count() / TIMED_ITERATIONS,
+            result.c_str());
+    }
+
+    canvas_host_free(canvas);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""Converts the app's PNG assets to icons for the host harness.
+
+The output mimics the icon sources the firmware build tools generate, with every image
+stored as a single uncompressed XBM frame. Only the standard library is used, so the PNG
+decoder covers just the non-interlaced images with up to 8 bits per channel.
+"""
+
+import os
+import struct
+import sys
+import zlib
+
+CHANNELS = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}
+
+
+def unfilter(raw, width, height, bits_per_pixel):
+    stride = (width * bits_per_pixel + 7) // 8
+    bpp = max(1, bits_per_pixel // 8)
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        filter_type = raw[pos]
+        row = bytearray(raw[pos + 1 : pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            a = row[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if filter_type == 1:
+                row[i] = (row[i] + a) & 0xFF
+            elif filter_type == 2:
+                row[i] = (row[i] + b) & 0xFF
+            elif filter_type == 3:
+                row[i] = (row[i] + (a + b) // 2) & 0xFF
+            elif filter_type == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                predictor = a if pa <= pb and pa <= pc else b if pb <= pc else c
+                row[i] = (row[i] + predictor) & 0xFF
+        rows.append(row)
+        prev = row
+    return rows
+
+
+def read_png(path):
+    """Returns the image as rows of booleans, True for black pixels"""
+    with open(path, "rb") as file:
+        data = file.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError(f"{path}: not a PNG file")
+
+    pos = 8
+    idat = b""
+    palette = None
+    while pos < len(data):
+        length, chunk_type = struct.unpack(">I4s", data[pos : pos + 8])
+        body = data[pos + 8 : pos + 8 + length]
+        pos += 12 + length
+        if chunk_type == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif chunk_type == b"PLTE":
+            palette = [body[i : i + 3] for i in range(0, len(body), 3)]
+        elif chunk_type == b"IDAT":
+            idat += body
+        elif chunk_type == b"IEND":
+            break
+
+    if interlace != 0 or depth > 8 or color_type not in CHANNELS:
+        raise ValueError(f"{path}: unsupported PNG format")
+
+    channels = CHANNELS[color_type]
+    rows = unfilter(zlib.decompress(idat), width, height, depth * channels)
+    max_value = (1 << depth) - 1
+
+    image = []
+    for row in rows:
+        pixels = []
+        for x in range(width):
+            samples = []
+            for channel in range(channels):
+                bit = (x * channels + channel) * depth
+                samples.append((row[bit // 8] >> (8 - depth - bit % 8)) & max_value)
+            if color_type == 3:
+                red, green, blue = palette[samples[0]]
+                alpha, luma = 255, (red + green + blue) // 3
+            else:
+                samples = [value * 255 // max_value for value in samples]
+                alpha = samples[-1] if color_type in (4, 6) else 255
+                luma = sum(samples[:3]) // 3 if color_type in (2, 6) else samples[0]
+            pixels.append(alpha >= 128 and luma < 128)
+        image.append(pixels)
+    return width, height, image
+
+
+def to_xbm(width, image):
+    data = bytearray()
+    for pixels in image:
+        for start in range(0, width, 8):
+            byte = 0
+            for bit, black in enumerate(pixels[start : start + 8]):
+                byte |= black << bit
+            data.append(byte)
+    return data
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(f"usage: {sys.argv[0]} <output dir> <app id> [<png>...]")
+
+    output_dir, app_id, assets = sys.argv[1], sys.argv[2], sorted(sys.argv[3:])
+    os.makedirs(output_dir, exist_ok=True)
+
+    header = ["#pragma once", "", "#include <gui/icon.h>", ""]
+    header += ["#ifdef __cplusplus", 'extern "C" {', "#endif", ""]
+    source = [f'#include "{app_id}_icons.h"', ""]
+    for asset in assets:
+        name = "I_" + os.path.splitext(os.path.basename(asset))[0]
+        width, height, image = read_png(asset)
+        frame = bytes([0x00]) + to_xbm(width, image)
+
+        header.append(f"extern const Icon {name};")
+        source.append(f"static const uint8_t _{name}_0[] = {{{','.join(f'0x{b:02x}' for b in frame)}}};")
+        source.append(f"static const uint8_t* const _{name}[] = {{_{name}_0}};")
+        source.append(
+            f"const Icon {name} = {{.width = {width}, .height = {height}, .frame_count = 1, "
+            f".frame_rate = 0, .frames = _{name}}};"
+        )
+        source.append("")
+    header += ["", "#ifdef __cplusplus", "}", "#endif", ""]
+
+    with open(os.path.join(output_dir, f"{app_id}_icons.h"), "w") as file:
+        file.write("\n".join(header))
+    with open(os.path.join(output_dir, f"{app_id}_icons.c"), "w") as file:
+        file.write("\n".join(source))
+
+
+if __name__ == "__main__":
+    main()
@@ -2,21 +2,270 @@
 
 #include <gui/canvas.h>
 
-static constexpr uint32_t HOR_BOX_LENGTH = 8;
-static constexpr uint32_t VERT_BOX_LENGTH = 12;
-static constexpr uint32_t HOR_SEGMENT_LENGTH = HOR_BOX_LENGTH + 2; // plus dots
-static constexpr uint32_t VERT_SEGMENT_LENGTH = VERT_BOX_LENGTH + 2;
-static constexpr uint32_t SEGMENT_SLANT = 1;
-static constexpr uint32_t SEGMENT_THICKNESS = 3;
-static constexpr uint32_t COLON_THICKNESS = 3;
-static constexpr uint32_t SEGMENT_NOTCH = 2;
-static constexpr uint32_t DIGIT_GAP = 4;
-
-static constexpr uint32_t GLYPH_SPACING = HOR_SEGMENT_LENGTH + (DIGIT_GAP * 2);
-static constexpr uint32_t COLON_SPACING = COLON_THICKNESS * 2;
-
-uint32_t
-    SevenSegmentDisplay::DrawNumberBCD(Canvas* canvas, uint8_t num_bcd, int32_t x, int32_t y) {
+#include <furi/core/check.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+static constexpr uint8_t DIGIT_CODES[10] = {
+    0b1111110, // 0
+    0b0110000, // 1
+    0b1101101, // 2
+    0b1111001, // 3
+    0b0110011, // 4
+    0b1011011, // 5
+    0b1011111, // 6
+    0b1110000, // 7
+    0b1111111, // 8
+    0b1111011, // 9
+};
+
+static constexpr uint8_t UPPERCASE_CODES[26] = {
+    0b1110111, // A
+    0b0011111, // b (B missing)
+    0b1001110, // C
+    0b0111101, // d (D missing)
+    0b1001111, // E
+    0b1000111, // F
+    0b1011110, // G
+    0b0110111, // H
+    0b0000110, // I
+    0b0111100, // J
+    0b0000000, // K and k missing
+    0b0001110, // L
+    0b0000000, // M special cased
+    0b1110110, // N
+    0b1111110, // O
+    0b1100111, // P
+    0b1110011, // q (Q missing)
+    0b0000101, // r (R missing)
+    0b1011011, // S
+    0b0001111, // t (T missing)
+    0b0111110, // U
+    0b0000000, // V and v missing
+    0b0000000, // W special cased
+    0b0000000, // X and x missing
+    0b0111011, // y (Y missing)
+    0b1101101, // Z
+};
+
+static constexpr uint8_t LOWERCASE_CODES[26] = {
+    0b1111101, // a
+    0b0011111, // b
+    0b0001101, // c
+    0b0111101, // d
+    0b1101111, // e
+    0b1000111, // F (f missing)
+    0b1111011, // g
+    0b0010111, // h
+    0b0010000, // i
+    0b0111000, // j
+    0b0000000, // K and k missing
+    0b0000110, // l
+    0b0000000, // M special cased
+    0b0010101, // n
+    0b0011101, // o
+    0b1100111, // P (p missing)
+    0b1110011, // q
+    0b0000101, // r
+    0b1011011, // S (s missing)
+    0b0001111, // t
+    0b0011100, // u
+    0b0000000, // V and v missing
+    0b0000000, // W special cased
+    0b0000000, // X and x missing
+    0b0111011, // y (Y missing)
+    0b1101101, // Z (z missing)
+};
+
+// M and W occupy two cells
+static constexpr uint8_t M_CODES[2] = {0b1100110, 0b1110010};
+static constexpr uint8_t W_CODES[2] = {0b0011110, 0b0111100};
+
+// The glyphs are made of boxes and dots (1x1 boxes). Both the segments and the colon are
+// described once, relative to the glyph's origin, and rasterized into XBM bitmaps at compile
+// time - so every character is drawn with a single blit, and changing the geometry
+// regenerates the bitmaps.
+template <typename Geometry, typename Func>
+static constexpr void ForEachSegmentBox(uint8_t code, Func&& box) {
+    using Display = BasicSevenSegmentDisplay<Geometry>;
+    constexpr uint32_t HOR_SEGMENT_LENGTH = Display::HOR_SEGMENT_LENGTH;
+    constexpr uint32_t VERT_SEGMENT_LENGTH = Display::VERT_SEGMENT_LENGTH;
+    constexpr uint32_t SEGMENT_SLANT = Geometry::SEGMENT_SLANT;
+    constexpr uint32_t SEGMENT_THICKNESS = Geometry::SEGMENT_THICKNESS;
+    constexpr uint32_t SEGMENT_NOTCH = Geometry::SEGMENT_NOTCH;
+
+    // The dots at the ends of the segments sit in the middle of their thickness
+    auto horizontal = [&box](int32_t x, int32_t y) {
+        box(x + 1, y, HOR_SEGMENT_LENGTH - 2, SEGMENT_THICKNESS);
+        box(x, y + (SEGMENT_THICKNESS / 2), 1, 1);
+        box(x + HOR_SEGMENT_LENGTH - 1, y + (SEGMENT_THICKNESS / 2), 1, 1);
+    };
+    auto vertical = [&box](int32_t x, int32_t y) {
+        const uint32_t PART_LENGTH = (VERT_SEGMENT_LENGTH - 2) / 2;
+        box(x + SEGMENT_SLANT, y + 1, SEGMENT_THICKNESS, PART_LENGTH);
+        box(x, y + PART_LENGTH + 1, SEGMENT_THICKNESS, PART_LENGTH);
+        box(x + SEGMENT_SLANT + (SEGMENT_THICKNESS / 2), y, 1, 1);
+        box(x + (SEGMENT_THICKNESS / 2), y + VERT_SEGMENT_LENGTH - 1, 1, 1);
+    };
+
+    // A
+    if((code & 0b1000000) != 0) {
+        horizontal((SEGMENT_SLANT * 2) + SEGMENT_THICKNESS, 0);
+    }
+
+    // B
+    if((code & 0b100000) != 0) {
+        vertical(HOR_SEGMENT_LENGTH + (SEGMENT_SLANT * 2) + 1, SEGMENT_NOTCH);
+    }
+
+    // C
+    if((code & 0b10000) != 0) {
+        vertical(HOR_SEGMENT_LENGTH + SEGMENT_SLANT + 1, VERT_SEGMENT_LENGTH + SEGMENT_THICKNESS);
+    }
+
+    // D
+    if((code & 0b1000) != 0) {
+        horizontal(SEGMENT_THICKNESS, (VERT_SEGMENT_LENGTH * 2) + SEGMENT_NOTCH);
+    }
+
+    // E
+    if((code & 0b100) != 0) {
+        vertical(SEGMENT_SLANT, VERT_SEGMENT_LENGTH + SEGMENT_THICKNESS);
+    }
+
+    // F
+    if((code & 0b10) != 0) {
+        vertical(SEGMENT_SLANT * 2, SEGMENT_NOTCH);
+    }
+
+    // G
+    if((code & 0b1) != 0) {
+        horizontal(SEGMENT_SLANT + SEGMENT_THICKNESS, VERT_SEGMENT_LENGTH + 1);
+    }
+}
+
+template <typename Geometry, typename Func>
+static constexpr void ForEachColonBox(Func&& box) {
+    using Display = BasicSevenSegmentDisplay<Geometry>;
+    constexpr uint32_t VERT_SEGMENT_LENGTH = Display::VERT_SEGMENT_LENGTH;
+    constexpr uint32_t SEGMENT_SLANT = Geometry::SEGMENT_SLANT;
+    constexpr uint32_t COLON_THICKNESS = Geometry::COLON_THICKNESS;
+
+    const uint32_t colon_height = (VERT_SEGMENT_LENGTH / 2);
+    box(SEGMENT_SLANT + 1, colon_height + (COLON_THICKNESS / 2), COLON_THICKNESS, COLON_THICKNESS);
+    box(1,
+        (VERT_SEGMENT_LENGTH * 2) - colon_height + (COLON_THICKNESS / 2),
+        COLON_THICKNESS,
+        COLON_THICKNESS);
+}
+
+// Smallest rectangle covering all the boxes
+struct BitmapBounds {
+    int32_t x, y;
+    uint32_t width, height;
+};
+
+template <typename ForEachBox>
+static constexpr BitmapBounds MeasureBoxes(ForEachBox&& for_each_box) {
+    int32_t min_x = std::numeric_limits<int32_t>::max(), min_y = min_x;
+    int32_t max_x = std::numeric_limits<int32_t>::min(), max_y = max_x;
+    for_each_box([&](int32_t x, int32_t y, uint32_t width, uint32_t height) {
+        min_x = std::min(min_x, x);
+        min_y = std::min(min_y, y);
+        max_x = std::max<int32_t>(max_x, x + width);
+        max_y = std::max<int32_t>(max_y, y + height);
+    });
+    return {min_x, min_y, uint32_t(max_x - min_x), uint32_t(max_y - min_y)};
+}
+
+template <BitmapBounds Bounds>
+struct Xbm {
+    static constexpr uint32_t STRIDE = (Bounds.width + 7) / 8;
+
+    template <typename ForEachBox>
+    static constexpr Xbm Rasterize(ForEachBox&& for_each_box) {
+        Xbm xbm;
+        for_each_box([&xbm](int32_t x, int32_t y, uint32_t width, uint32_t height) {
+            for(uint32_t row = y - Bounds.y; row < y - Bounds.y + height; row++) {
+                for(uint32_t col = x - Bounds.x; col < x - Bounds.x + width; col++) {
+                    xbm.data[row * STRIDE + col / 8] |= 1 << (col % 8);
+                }
+            }
+        });
+        return xbm;
+    }
+
+    // The bitmap mode is left to the caller, see BasicSevenSegmentDisplay
+    void Draw(Canvas* canvas, int32_t x, int32_t y) const {
+        canvas_draw_xbm(
+            canvas, x + Bounds.x, y + Bounds.y, Bounds.width, Bounds.height, data.data());
+    }
+
+    std::array<uint8_t, STRIDE * Bounds.height> data{};
+};
+
+// Only the codes the tables use are rasterized, indexed by code. Code 0 draws nothing.
+static constexpr uint8_t NO_GLYPH = 0xFF;
+static constexpr std::array<uint8_t, 128> GLYPH_INDICES = [] {
+    std::array<uint8_t, 128> indices;
+    indices.fill(NO_GLYPH);
+
+    uint8_t count = 0;
+    auto add = [&](const auto& codes) {
+        for(uint8_t code : codes) {
+            if(code != 0 && indices[code] == NO_GLYPH) {
+                indices[code] = count++;
+            }
+        }
+    };
+    add(DIGIT_CODES);
+    add(UPPERCASE_CODES);
+    add(LOWERCASE_CODES);
+    add(M_CODES);
+    add(W_CODES);
+    return indices;
+}();
+
+static constexpr std::size_t GLYPH_COUNT =
+    std::ranges::count_if(GLYPH_INDICES, [](uint8_t index) { return index != NO_GLYPH; });
+
+template <typename Geometry>
+static constexpr auto SegmentBoxes(uint8_t code) {
+    return [code](auto&& box) { ForEachSegmentBox<Geometry>(code, box); };
+}
+
+template <typename Geometry>
+static constexpr auto ColonBoxes() {
+    return [](auto&& box) { ForEachColonBox<Geometry>(box); };
+}
+
+template <typename Geometry>
+struct GlyphBitmaps {
+    // An 8 lights up every segment
+    static constexpr BitmapBounds GLYPH_BOUNDS = MeasureBoxes(SegmentBoxes<Geometry>(0b1111111));
+    static constexpr BitmapBounds COLON_BOUNDS = MeasureBoxes(ColonBoxes<Geometry>());
+
+    static constexpr auto COLON = Xbm<COLON_BOUNDS>::Rasterize(ColonBoxes<Geometry>());
+    static constexpr auto GLYPHS = [] {
+        std::array<Xbm<GLYPH_BOUNDS>, GLYPH_COUNT> atlas;
+        for(uint8_t code = 0; code < GLYPH_INDICES.size(); code++) {
+            if(GLYPH_INDICES[code] != NO_GLYPH) {
+                atlas[GLYPH_INDICES[code]] =
+                    Xbm<GLYPH_BOUNDS>::Rasterize(SegmentBoxes<Geometry>(code));
+            }
+        }
+        return atlas;
+    }();
+};
+
+template <typename Geometry>
+uint32_t BasicSevenSegmentDisplay<Geometry>::DrawNumberBCD(
+    Canvas* canvas,
+    uint8_t num_bcd,
+    int32_t x,
+    int32_t y) {
     const uint8_t first = (num_bcd >> 4) & 0xF;
     const uint8_t second = num_bcd & 0xF;
     uint32_t result = DrawDigit(canvas, first, x, y);
@@ -24,7 +273,8 @@ uint32_t
     return result;
 }
 
-uint32_t SevenSegmentDisplay::DrawNumber(
+template <typename Geometry>
+uint32_t BasicSevenSegmentDisplay<Geometry>::DrawNumber(
     Canvas* canvas,
     uint32_t num,
     int32_t x,
@@ -69,104 +319,43 @@ uint32_t SevenSegmentDisplay::DrawNumber(
     return result;
 }
 
-uint32_t SevenSegmentDisplay::DrawDigit(Canvas* canvas, uint8_t digit, int32_t x, int32_t y) {
+template <typename Geometry>
+uint32_t BasicSevenSegmentDisplay<Geometry>::DrawDigit(
+    Canvas* canvas,
+    uint8_t digit,
+    int32_t x,
+    int32_t y) {
     // TODO: cookie_debug_check(digit < 10);
-    static const uint8_t DISPLAY_CODING_CHARACTERS[10] = {
-        0b1111110, // 0
-        0b0110000, // 1
-        0b1101101, // 2
-        0b1111001, // 3
-        0b0110011, // 4
-        0b1011011, // 5
-        0b1011111, // 6
-        0b1110000, // 7
-        0b1111111, // 8
-        0b1111011, // 9
-    };
-    return DrawGlyph(canvas, DISPLAY_CODING_CHARACTERS[digit], x, y);
+    return DrawGlyph(canvas, DIGIT_CODES[digit], x, y);
 }
 
-uint32_t SevenSegmentDisplay::DrawGlyph(Canvas* canvas, uint8_t code, int32_t x, int32_t y) {
-    if(canvas) {
-        // A
-        if((code & 0b1000000) != 0) {
-            DrawHorizontalSegment(canvas, x + (SEGMENT_SLANT * 2) + SEGMENT_THICKNESS, y);
-        }
-
-        // B
-        if((code & 0b100000) != 0) {
-            DrawVerticalSegment(
-                canvas, x + HOR_SEGMENT_LENGTH + (SEGMENT_SLANT * 2) + 1, y + SEGMENT_NOTCH);
-        }
-
-        // C
-        if((code & 0b10000) != 0) {
-            DrawVerticalSegment(
-                canvas,
-                x + HOR_SEGMENT_LENGTH + SEGMENT_SLANT + 1,
-                y + VERT_SEGMENT_LENGTH + SEGMENT_THICKNESS);
-        }
-
-        // D
-        if((code & 0b1000) != 0) {
-            DrawHorizontalSegment(
-                canvas, x + SEGMENT_THICKNESS, y + (VERT_SEGMENT_LENGTH * 2) + SEGMENT_NOTCH);
-        }
-
-        // E
-        if((code & 0b100) != 0) {
-            DrawVerticalSegment(
-                canvas, x + SEGMENT_SLANT, y + VERT_SEGMENT_LENGTH + SEGMENT_THICKNESS);
-        }
-
-        // F
-        if((code & 0b10) != 0) {
-            DrawVerticalSegment(canvas, x + (SEGMENT_SLANT * 2), y + SEGMENT_NOTCH);
-        }
-
-        // G
-        if((code & 0b1) != 0) {
-            DrawHorizontalSegment(
-                canvas, x + SEGMENT_SLANT + SEGMENT_THICKNESS, y + VERT_SEGMENT_LENGTH + 1);
-        }
+template <typename Geometry>
+uint32_t BasicSevenSegmentDisplay<Geometry>::DrawGlyph(
+    Canvas* canvas,
+    uint8_t code,
+    int32_t x,
+    int32_t y) {
+    if(canvas && code != 0) {
+        furi_assert(code < GLYPH_INDICES.size() && GLYPH_INDICES[code] != NO_GLYPH);
+        GlyphBitmaps<Geometry>::GLYPHS[GLYPH_INDICES[code]].Draw(canvas, x, y);
     }
     return GLYPH_SPACING;
 }
 
-void SevenSegmentDisplay::DrawHorizontalSegment(Canvas* canvas, int32_t x, int32_t y) {
-    canvas_draw_box(canvas, x + 1, y, HOR_SEGMENT_LENGTH - 2, SEGMENT_THICKNESS);
-    canvas_draw_dot(canvas, x, y + 1);
-    canvas_draw_dot(canvas, x + HOR_SEGMENT_LENGTH - 1, y + 1);
-}
-
-void SevenSegmentDisplay::DrawVerticalSegment(Canvas* canvas, int32_t x, int32_t y) {
-    const uint32_t PART_LENGTH = (VERT_SEGMENT_LENGTH - 2) / 2;
-    canvas_draw_box(canvas, x + SEGMENT_SLANT, y + 1, SEGMENT_THICKNESS, PART_LENGTH);
-    canvas_draw_box(canvas, x, y + PART_LENGTH + 1, SEGMENT_THICKNESS, PART_LENGTH);
-    canvas_draw_dot(canvas, x + SEGMENT_SLANT + 1, y);
-    canvas_draw_dot(canvas, x + 1, y + VERT_SEGMENT_LENGTH - 1);
-}
-
-uint32_t SevenSegmentDisplay::DrawColon(Canvas* canvas, int32_t x, int32_t y) {
+template <typename Geometry>
+uint32_t BasicSevenSegmentDisplay<Geometry>::DrawColon(Canvas* canvas, int32_t x, int32_t y) {
     if(canvas) {
-        const uint32_t colon_height = (VERT_SEGMENT_LENGTH / 2);
-        canvas_draw_box(
-            canvas,
-            x + SEGMENT_SLANT + 1,
-            y + colon_height + (COLON_THICKNESS / 2),
-            COLON_THICKNESS,
-            COLON_THICKNESS);
-        canvas_draw_box(
-            canvas,
-            x + 1,
-            y + (VERT_SEGMENT_LENGTH * 2) - colon_height + (COLON_THICKNESS / 2),
-            COLON_THICKNESS,
-            COLON_THICKNESS);
+        GlyphBitmaps<Geometry>::COLON.Draw(canvas, x, y);
     }
     return COLON_SPACING;
 }
 
-uint32_t SevenSegmentDisplay::DrawString(Canvas* canvas, const char* str, int32_t x, int32_t y) {
+template <typename Geometry>
+uint32_t BasicSevenSegmentDisplay<Geometry>::DrawString(
+    Canvas* canvas,
+    const char* str,
+    int32_t x,
+    int32_t y) {
     uint32_t width = 0;
     while(*str != '\0') {
         width += DrawChar(canvas, *str++, x + width, y);
@@ -174,7 +363,12 @@ uint32_t SevenSegmentDisplay::DrawString(Canvas* canvas, const char* str, int32_
     return width;
 }
 
-uint32_t SevenSegmentDisplay::DrawChar(Canvas* canvas, char ch, int32_t x, int32_t y) {
+template <typename Geometry>
+uint32_t BasicSevenSegmentDisplay<Geometry>::DrawChar(
+    Canvas* canvas,
+    char ch,
+    int32_t x,
+    int32_t y) {
     if(ch >= '0' && ch <= '9') {
         return DrawDigit(canvas, ch - '0', x, y);
     }
@@ -184,84 +378,27 @@ uint32_t SevenSegmentDisplay::DrawChar(Canvas* canvas, char ch, int32_t x, int32
 
     // M and W occupy two cells, special case them
     if(ch == 'M' || ch == 'm') {
-        const uint32_t left = DrawGlyph(canvas, 0b1100110, x, y);
-        const uint32_t right = DrawGlyph(canvas, 0b1110010, x + left, y);
+        const uint32_t left = DrawGlyph(canvas, M_CODES[0], x, y);
+        const uint32_t right = DrawGlyph(canvas, M_CODES[1], x + left, y);
         return left + right;
     }
     if(ch == 'W' || ch == 'w') {
-        const uint32_t left = DrawGlyph(canvas, 0b0011110, x, y);
-        const uint32_t right = DrawGlyph(canvas, 0b0111100, x + left, y);
+        const uint32_t left = DrawGlyph(canvas, W_CODES[0], x, y);
+        const uint32_t right = DrawGlyph(canvas, W_CODES[1], x + left, y);
         return left + right;
     }
 
     if(ch >= 'A' && ch <= 'Z') {
-        static const uint8_t DISPLAY_CODING_CHARACTERS[26] = {
-            0b1110111, // A
-            0b0011111, // b (B missing)
-            0b1001110, // C
-            0b0111101, // d (D missing)
-            0b1001111, // E
-            0b1000111, // F
-            0b1011110, // G
-            0b0110111, // H
-            0b0000110, // I
-            0b0111100, // J
-            0b0000000, // K and k missing
-            0b0001110, // L
-            0b0000000, // M special cased
-            0b1110110, // N
-            0b1111110, // O
-            0b1100111, // P
-            0b1110011, // q (Q missing)
-            0b0000101, // r (R missing)
-            0b1011011, // S
-            0b0001111, // t (T missing)
-            0b0111110, // U
-            0b0000000, // V and v missing
-            0b0000000, // W special cased
-            0b0000000, // X and x missing
-            0b0111011, // y (Y missing)
-            0b1101101, // Z
-        };
-        return DrawGlyph(canvas, DISPLAY_CODING_CHARACTERS[ch - 'A'], x, y);
+        return DrawGlyph(canvas, UPPERCASE_CODES[ch - 'A'], x, y);
     }
 
     if(ch >= 'a' && ch <= 'z') {
-        static const uint8_t DISPLAY_CODING_CHARACTERS[26] = {
-            0b1111101, // a
-            0b0011111, // b
-            0b0001101, // c
-            0b0111101, // d
-            0b1101111, // e
-            0b1000111, // F (f missing)
-            0b1111011, // g
-            0b0010111, // h
-            0b0010000, // i
-            0b0111000, // j
-            0b0000000, // K and k missing
-            0b0000110, // l
-            0b0000000, // M special cased
-            0b0010101, // n
-            0b0011101, // o
-            0b1100111, // P (p missing)
-            0b1110011, // q
-            0b0000101, // r
-            0b1011011, // S (s missing)
-            0b0001111, // t
-            0b0011100, // u
-            0b0000000, // V and v missing
-            0b0000000, // W special cased
-            0b0000000, // X and x missing
-            0b0111011, // y (Y missing)
-            0b1101101, // Z (z missing)
-        };
-        return DrawGlyph(canvas, DISPLAY_CODING_CHARACTERS[ch - 'a'], x, y);
+        return DrawGlyph(canvas, LOWERCASE_CODES[ch - 'a'], x, y);
     }
 
     // Space and other unsupported characters will leave a narrow space
     return COLON_SPACING;
 }
 
-uint32_t SevenSegmentDisplay::GetGlyphHeight() {
-    return (2 * VERT_SEGMENT_LENGTH) + 5;
-}
+template class BasicSevenSegmentDisplay<SevenSegmentGeometryLarge>;
+template class BasicSevenSegmentDisplay<SevenSegmentGeometrySmall>;
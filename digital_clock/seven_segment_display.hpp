@@ -4,9 +4,42 @@
 
 struct Canvas;
 
-class SevenSegmentDisplay {
+// Seven-segment geometry policies, all lengths in pixels
+struct SevenSegmentGeometryLarge {
+    static constexpr uint32_t HOR_BOX_LENGTH = 8;
+    static constexpr uint32_t VERT_BOX_LENGTH = 12;
+    static constexpr uint32_t SEGMENT_SLANT = 1;
+    static constexpr uint32_t SEGMENT_THICKNESS = 3;
+    static constexpr uint32_t COLON_THICKNESS = 3;
+    static constexpr uint32_t SEGMENT_NOTCH = 2;
+    static constexpr uint32_t DIGIT_GAP = 4;
+};
+
+struct SevenSegmentGeometrySmall {
+    static constexpr uint32_t HOR_BOX_LENGTH = 4;
+    static constexpr uint32_t VERT_BOX_LENGTH = 6;
+    static constexpr uint32_t SEGMENT_SLANT = 1;
+    static constexpr uint32_t SEGMENT_THICKNESS = 2;
+    static constexpr uint32_t COLON_THICKNESS = 2;
+    static constexpr uint32_t SEGMENT_NOTCH = 1;
+    static constexpr uint32_t DIGIT_GAP = 2;
+};
+
+// Every geometry gets its own glyph bitmaps and drawing code, generated at compile time.
+// The drawing code is instantiated in seven_segment_display.cpp, add new geometries there.
+template <typename Geometry>
+class BasicSevenSegmentDisplay {
 public:
+    static constexpr uint32_t HOR_SEGMENT_LENGTH = Geometry::HOR_BOX_LENGTH + 2; // plus dots
+    static constexpr uint32_t VERT_SEGMENT_LENGTH = Geometry::VERT_BOX_LENGTH + 2;
+    static constexpr uint32_t GLYPH_SPACING = HOR_SEGMENT_LENGTH + (Geometry::DIGIT_GAP * 2);
+    static constexpr uint32_t COLON_SPACING = Geometry::COLON_THICKNESS * 2;
+    static constexpr uint32_t GLYPH_HEIGHT =
+        (2 * VERT_SEGMENT_LENGTH) + Geometry::SEGMENT_NOTCH + Geometry::SEGMENT_THICKNESS;
+
     // All public routines return the width of the element drawn, with padding
+    // Glyphs are drawn as bitmaps in the canvas's current bitmap mode. Enable it around the calls
+    // drawing over other content, or the unlit pixels of each glyph's box erase it
     // Passing a null canvas draws nothing and returns the width of the elements that would have been drawn
     static uint32_t DrawNumberBCD(Canvas* canvas, uint8_t num_bcd, int32_t x, int32_t y);
     // min_digits > 0 - adds at least as many trailing zeroes
@@ -23,11 +56,36 @@ public:
     static uint32_t DrawString(Canvas* canvas, const char* str, int32_t x, int32_t y);
     static uint32_t DrawChar(Canvas* canvas, char ch, int32_t x, int32_t y);
 
-    static uint32_t GetGlyphHeight();
+    // Widths of what DrawString and DrawChar would draw, usable in constant expressions
+    static constexpr uint32_t MeasureString(const char* str) {
+        uint32_t width = 0;
+        while(*str != '\0') {
+            width += MeasureChar(*str++);
+        }
+        return width;
+    }
+
+    static constexpr uint32_t MeasureChar(char ch) {
+        if((ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z')) {
+            // M and W occupy two cells
+            const bool two_cells = ch == 'M' || ch == 'm' || ch == 'W' || ch == 'w';
+            return two_cells ? GLYPH_SPACING * 2 : GLYPH_SPACING;
+        }
+        // The colon, and the narrow space left for unsupported characters
+        return COLON_SPACING;
+    }
+
+    static constexpr uint32_t GetGlyphHeight() {
+        return GLYPH_HEIGHT;
+    }
 
 private:
     static uint32_t DrawDigit(Canvas* canvas, uint8_t digit, int32_t x, int32_t y);
     static uint32_t DrawGlyph(Canvas* canvas, uint8_t code, int32_t, int32_t y);
-    static void DrawHorizontalSegment(Canvas* canvas, int32_t x, int32_t y);
-    static void DrawVerticalSegment(Canvas* canvas, int32_t x, int32_t y);
 };
+
+extern template class BasicSevenSegmentDisplay<SevenSegmentGeometryLarge>;
+extern template class BasicSevenSegmentDisplay<SevenSegmentGeometrySmall>;
+
+using SevenSegmentDisplay = BasicSevenSegmentDisplay<SevenSegmentGeometryLarge>;
+using SmallSevenSegmentDisplay = BasicSevenSegmentDisplay<SevenSegmentGeometrySmall>;
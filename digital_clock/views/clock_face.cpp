@@ -0,0 +1,89 @@
+#include "clock_face.hpp"
+
+#include "seven_segment_display.hpp"
+
+#include <gui/canvas.h>
+#include <gui/elements.h>
+
+#include <digital_clock_icons.h>
+
+#include <stdio.h>
+
+void ClockFace::Draw(Canvas* canvas, const ClockFace& face) {
+    canvas_clear(canvas);
+
+    const bool show_seconds = face.tick_rate != TickRate::Minute;
+    // Without seconds, HH:MM is centered instead
+    constexpr int32_t HH_MM_X = (128 - SevenSegmentDisplay::MeasureString("00:00")) / 2;
+
+    int32_t cur_x;
+    const int32_t cur_y = 24;
+
+    bool is_pm = face.hour >= 12;
+    canvas_set_bitmap_mode(canvas, true);
+    if(!face.twelve_hour_clock) {
+        cur_x = show_seconds ? 4 : HH_MM_X;
+        cur_x += SevenSegmentDisplay::DrawNumber(canvas, face.hour, cur_x, cur_y, 2);
+    } else {
+        uint8_t hour_12h = face.hour % 12;
+        if(hour_12h == 0) {
+            hour_12h = 12;
+        }
+        cur_x = show_seconds ? 0 : HH_MM_X;
+        cur_x += SevenSegmentDisplay::DrawNumber(canvas, hour_12h, cur_x, cur_y, 2, true);
+    }
+    cur_x += SevenSegmentDisplay::DrawColon(face.show_colon ? canvas : nullptr, cur_x, cur_y);
+
+    cur_x += SevenSegmentDisplay::DrawNumber(canvas, face.minute, cur_x, cur_y, 2);
+    if(show_seconds) {
+        cur_x += SevenSegmentDisplay::DrawColon(face.show_colon ? canvas : nullptr, cur_x, cur_y);
+        cur_x += SevenSegmentDisplay::DrawNumber(canvas, face.second, cur_x, cur_y, 2);
+    }
+    canvas_set_bitmap_mode(canvas, false);
+    if(face.twelve_hour_clock) {
+        canvas_set_font(canvas, FontSecondary);
+        canvas_draw_str_aligned(
+            canvas, 128, cur_y - 1, AlignRight, AlignBottom, is_pm ? "PM" : "AM");
+    }
+
+    if(face.stats_shown) {
+        DrawStats(canvas, face);
+    }
+
+    if(face.lock_screen_shown) {
+        DrawLockScreen(canvas);
+    }
+}
+
+void ClockFace::DrawStats(Canvas* canvas, const ClockFace& face) {
+    const char* rate = "2Hz";
+    if(face.tick_rate == TickRate::Second) {
+        rate = "1Hz";
+    } else if(face.tick_rate == TickRate::Minute) {
+        rate = "1/min";
+    }
+
+    char str[32];
+    snprintf(
+        str,
+        sizeof(str),
+        "%s, %lu wakeups/h",
+        rate,
+        static_cast<unsigned long>(face.wakeups_per_hour));
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str_aligned(canvas, 64, 64, AlignCenter, AlignBottom, str);
+}
+
+void ClockFace::DrawLockScreen(Canvas* canvas) {
+    constexpr uint32_t y_shift = 13;
+
+    canvas_set_font(canvas, FontSecondary);
+    elements_bold_rounded_frame(canvas, 14, 2 + y_shift, 99, 48);
+    elements_multiline_text(canvas, 65, 20 + y_shift, "To exit\npress:");
+    canvas_set_bitmap_mode(canvas, true);
+    canvas_draw_icon(canvas, 65, 36 + y_shift, &I_Pin_back_arrow_10x8);
+    canvas_draw_icon(canvas, 80, 36 + y_shift, &I_Pin_back_arrow_10x8);
+    canvas_draw_icon(canvas, 95, 36 + y_shift, &I_Pin_back_arrow_10x8);
+    canvas_draw_icon(canvas, 16, 7 + y_shift, &I_WarningDolphin_45x42);
+    canvas_set_bitmap_mode(canvas, false);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <furi/core/base.h>
+
+struct Canvas;
+
+// How often the clock wakes up to update the face
+enum class TickRate : uint8_t {
+    HalfSecond, // The colon blinks
+    Second, // The colon stays on
+    Minute, // Seconds are hidden
+};
+
+// Everything the clock view displays. Drawing it takes nothing but a canvas,
+// so the host harness can render it without the rest of the app.
+struct ClockFace {
+    bool operator==(const ClockFace&) const = default;
+
+    static void Draw(Canvas* canvas, const ClockFace& face);
+
+    uint8_t hour = 0, minute = 0, second = 0;
+    bool show_colon = false;
+
+    bool lock_screen_shown = false;
+
+    bool twelve_hour_clock = false;
+
+    TickRate tick_rate = TickRate::HalfSecond;
+
+    // Wakeup statistics line, toggled from the clock view
+    bool stats_shown = false;
+    uint32_t wakeups_per_hour = 0;
+
+private:
+    static void DrawStats(Canvas* canvas, const ClockFace& face);
+    static void DrawLockScreen(Canvas* canvas);
+};
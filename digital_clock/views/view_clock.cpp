@@ -1,27 +1,26 @@
 #include "view_clock.hpp"
 
 #include "digital_clock_app.hpp"
-#include "seven_segment_display.hpp"
 
-#include <gui/canvas.h>
-#include <gui/elements.h>
 #include <stm32wbxx_ll_rtc.h>
 
+#include <furi/core/log.h>
 #include <furi_hal_rtc.h>
 
 #include <chrono>
 #include <cookie/common>
+#include <cookie/when>
 
-#include <digital_clock_icons.h>
+#define TAG "DigitalClock"
 
 DigitalClockView::DigitalClockView(FuriEventLoop* event_loop)
     : m_view(furi_hal_rtc_get_locale_timeformat() == FuriHalRtcLocaleTimeFormat12h)
+    , m_redraw_coalescer(event_loop, *m_view)
     , PREDIV_S(LL_RTC_GetSynchPrescaler(RTC))
     , m_lock_overlay(event_loop) {
     view_set_context(*m_view, this);
     view_set_draw_callback(*m_view, [](Canvas* canvas, void* mdl) {
-        const Model* model = reinterpret_cast<const Model*>(mdl);
-        OnDraw(canvas, *model);
+        ClockFace::Draw(canvas, cookie::view_model_snapshot<Model>(mdl));
     });
     view_set_enter_callback(*m_view, [](void* context) {
         DigitalClockView* view = reinterpret_cast<DigitalClockView*>(context);
@@ -31,13 +30,6 @@ DigitalClockView::DigitalClockView(FuriEventLoop* event_loop)
         DigitalClockView* view = reinterpret_cast<DigitalClockView*>(context);
         view->OnExit();
     });
-    view_set_custom_callback(*m_view, [](uint32_t event, void* context) {
-        DigitalClockView* view = reinterpret_cast<DigitalClockView*>(context);
-        if(event == cookie::furi_enum_param(AppLogicEvent::TickTock)) {
-            view->OnTimeUpdate();
-        }
-        return false;
-    });
     view_set_input_callback(*m_view, [](InputEvent* event, void* context) {
         DigitalClockView* view = reinterpret_cast<DigitalClockView*>(context);
         return view->OnInput(event);
@@ -45,79 +37,81 @@ DigitalClockView::DigitalClockView(FuriEventLoop* event_loop)
 }
 
 void DigitalClockView::OnEnter() {
-    OnTimeUpdate();
+    OnTimeUpdate(SampleRtc());
 }
 
 void DigitalClockView::OnExit() {
     m_lock_overlay.OnExit();
+
+    const auto& stats = m_redraw_coalescer.get_statistics();
+    FURI_LOG_D(
+        TAG,
+        "Model updates: %lu, changes: %lu, redraws: %lu",
+        stats.updates,
+        stats.changes,
+        stats.redraws);
 }
 
-void DigitalClockView::OnTimeUpdate() {
+RtcTimestamp DigitalClockView::SampleRtc() {
     // STM32L496xx errata stated that RTC time needs to be read twice as the lock may fail,
     // but the STM32WB55Rx errata does not state this. While the earlier version of this code
     // implemented the loop, now we're hoping that a single read is enough.
-    uint32_t subsecond, time;
+    // Also called from the tick-tock ISR, FURI_CRITICAL is safe to use there.
+    RtcTimestamp timestamp;
     {
         cookie::ScopedFuriCritical critical;
-        subsecond = LL_RTC_TIME_GetSubSecond(RTC);
-        time = LL_RTC_TIME_Get(RTC);
+        timestamp.subsecond = LL_RTC_TIME_GetSubSecond(RTC);
+        timestamp.time = LL_RTC_TIME_Get(RTC);
         LL_RTC_DATE_Get(RTC); // Unlock the shadow registers
     }
+    return timestamp;
+}
 
-    const uint8_t tenths_of_second = ((PREDIV_S - subsecond) * 10) / (PREDIV_S + 1);
+void DigitalClockView::OnTimeUpdate(const RtcTimestamp& timestamp) {
+    const uint32_t time = timestamp.time;
+    // The colon blinks, shown for the first half of every second
+    const bool first_half = (PREDIV_S - timestamp.subsecond) * 2 < PREDIV_S + 1;
+    const uint32_t wakeups_per_hour = get_outer()->GetTickTockWakeupsPerHour();
+
+    cookie::with_view_model(
+        m_redraw_coalescer, [time, first_half, wakeups_per_hour](Model& model) {
+            model.hour = __LL_RTC_CONVERT_BCD2BIN(__LL_RTC_GET_HOUR(time));
+            model.minute = __LL_RTC_CONVERT_BCD2BIN(__LL_RTC_GET_MINUTE(time));
+            model.second = __LL_RTC_CONVERT_BCD2BIN(__LL_RTC_GET_SECOND(time));
+            // Slower tick rates can't blink it, so keep it on
+            model.show_colon = first_half || model.tick_rate != TickRate::HalfSecond;
+            if(model.stats_shown) {
+                model.wakeups_per_hour = wakeups_per_hour;
+            }
+        });
+}
 
-    cookie::with_view_model(*m_view, [time, tenths_of_second](Model& model) {
-        model.hour = __LL_RTC_CONVERT_BCD2BIN(__LL_RTC_GET_HOUR(time));
-        model.minute = __LL_RTC_CONVERT_BCD2BIN(__LL_RTC_GET_MINUTE(time));
-        model.second = __LL_RTC_CONVERT_BCD2BIN(__LL_RTC_GET_SECOND(time));
-        model.tenths_of_second = tenths_of_second;
-    });
+void DigitalClockView::SetTickRate(TickRate rate) {
+    cookie::with_view_model(m_redraw_coalescer, [rate](Model& model) { model.tick_rate = rate; });
+    OnTimeUpdate(SampleRtc());
 }
 
 bool DigitalClockView::OnInput(const InputEvent* event) {
+    get_outer()->OnUserActivity();
+
     if(m_lock_overlay.OnInput(event)) {
         return true;
     }
-    return false;
-}
-
-void DigitalClockView::OnDraw(Canvas* canvas, const Model& model) {
-    canvas_clear(canvas);
-
-    int32_t cur_x;
-    const int32_t cur_y = 24;
-
-    const bool show_colon = model.tenths_of_second < 5;
-
-    bool is_pm = model.hour >= 12;
-    if(!model.twelve_hour_clock) {
-        cur_x = 4;
-        cur_x += SevenSegmentDisplay::DrawNumber(canvas, model.hour, cur_x, cur_y, 2);
-    } else {
-        uint8_t hour_12h = model.hour % 12;
-        if(hour_12h == 0) {
-            hour_12h = 12;
-        }
-        cur_x = 0;
-        cur_x += SevenSegmentDisplay::DrawNumber(canvas, hour_12h, cur_x, cur_y, 2, true);
-    }
-    cur_x += SevenSegmentDisplay::DrawColon(show_colon ? canvas : nullptr, cur_x, cur_y);
-
-    cur_x += SevenSegmentDisplay::DrawNumber(canvas, model.minute, cur_x, cur_y, 2);
-    cur_x += SevenSegmentDisplay::DrawColon(show_colon ? canvas : nullptr, cur_x, cur_y);
 
-    cur_x += SevenSegmentDisplay::DrawNumber(canvas, model.second, cur_x, cur_y, 2);
-    if(model.twelve_hour_clock) {
-        canvas_set_font(canvas, FontSecondary);
-        canvas_draw_str_aligned(
-            canvas, 128, cur_y - 1, AlignRight, AlignBottom, is_pm ? "PM" : "AM");
+    if(event->type == InputTypeShort && event->key == InputKeyUp) {
+        const uint32_t wakeups_per_hour = get_outer()->GetTickTockWakeupsPerHour();
+        cookie::with_view_model(m_redraw_coalescer, [wakeups_per_hour](Model& model) {
+            model.stats_shown = !model.stats_shown;
+            model.wakeups_per_hour = wakeups_per_hour;
+        });
+        return true;
     }
-
-    LockScreenOverlay::OnDraw(canvas, model);
+    return false;
 }
 
 void DigitalClockView::ShowLockScreen(bool show) {
-    cookie::with_view_model(*m_view, [show](Model& model) { model.lock_screen_shown = show; });
+    cookie::with_view_model(
+        m_redraw_coalescer, [show](Model& model) { model.lock_screen_shown = show; });
 }
 
 const uint32_t LOCK_TIMEOUT_TICKS =
@@ -134,48 +128,26 @@ void DigitalClockView::LockScreenOverlay::OnExit() {
 
 bool DigitalClockView::LockScreenOverlay::OnInput(const InputEvent* event) {
     if(event->type == InputTypeShort && event->key == InputKeyBack) {
-        m_lock_timer.wake_up();
-
-        auto task_result = m_lock_task.try_take_result();
-        if(task_result.value_or(false)) {
-            // Successfully skipped, pass the input to the actual handler
-            return false;
+        if(m_back_presses.dispatch(*event)) {
+            // If that was the last press needed, pass the input to the actual handler
+            return !m_lock_task.try_take_result().value_or(false);
         }
 
-        if(!m_lock_task.is_running()) {
-            // Either timed out, or not started yet - so restart
-            m_lock_timer.reset();
-            m_lock_task = ProcessExitInputsAsync();
-        }
+        // Either timed out, or not started yet - so restart
+        m_lock_task = ProcessExitInputsAsync();
         return true;
     }
     return false;
 }
 
-void DigitalClockView::LockScreenOverlay::OnDraw(Canvas* canvas, const Model& model) {
-    if(!model.lock_screen_shown) {
-        return;
-    }
-
-    constexpr uint32_t y_shift = 13;
-
-    canvas_set_font(canvas, FontSecondary);
-    elements_bold_rounded_frame(canvas, 14, 2 + y_shift, 99, 48);
-    elements_multiline_text(canvas, 65, 20 + y_shift, "To exit\npress:");
-    canvas_set_bitmap_mode(canvas, true);
-    canvas_draw_icon(canvas, 65, 36 + y_shift, &I_Pin_back_arrow_10x8);
-    canvas_draw_icon(canvas, 80, 36 + y_shift, &I_Pin_back_arrow_10x8);
-    canvas_draw_icon(canvas, 95, 36 + y_shift, &I_Pin_back_arrow_10x8);
-    canvas_draw_icon(canvas, 16, 7 + y_shift, &I_WarningDolphin_45x42);
-    canvas_set_bitmap_mode(canvas, false);
-}
-
 cookie::Task<bool> DigitalClockView::LockScreenOverlay::ProcessExitInputsAsync() {
     DigitalClockView* clock_view = get_outer();
     clock_view->ShowLockScreen(true);
 
     for(uint32_t i = 0; i < LOCK_PRESS_COUNT; i++) {
-        if(co_await m_lock_timer.await_delay(LOCK_TIMEOUT_TICKS)) {
+        auto press = co_await cookie::when_any(
+            m_lock_timer.await_delay(LOCK_TIMEOUT_TICKS), m_back_presses.next());
+        if(press.index() == 0) {
             // Timed out
             clock_view->ShowLockScreen(false);
             co_return false;
@@ -3,11 +3,20 @@
 #include <cookie/coroutine>
 #include <cookie/timer>
 #include <cookie/within>
+#include <cookie/gui/input>
 #include <cookie/gui/view>
 #include <cookie/gui/view_dispatcher>
 
+#include "clock_face.hpp"
+
 class DigitalClockApp;
 
+// Raw RTC time and subsecond registers, sampled together
+struct RtcTimestamp {
+    uint32_t time;
+    uint32_t subsecond;
+};
+
 class DigitalClockView : cookie::Within<DigitalClockView, DigitalClockApp>,
                          cookie::EnableWithin<DigitalClockView> {
 public:
@@ -17,25 +26,29 @@ public:
         return m_view;
     }
 
-private:
-    struct Model {
-        Model(bool twelve_hour_clock)
-            : twelve_hour_clock(twelve_hour_clock) {
-        }
-
-        uint8_t hour, minute, second;
-        uint8_t tenths_of_second;
+    const auto& GetRedrawStatistics() const {
+        return m_redraw_coalescer.get_statistics();
+    }
 
-        bool lock_screen_shown;
+    static RtcTimestamp SampleRtc();
+    void OnTimeUpdate(const RtcTimestamp& timestamp);
+    void SetTickRate(TickRate rate);
 
-        const bool twelve_hour_clock;
+private:
+    struct Model : ClockFace {
+        // Updated several times a second, don't make the GUI thread wait for the updates,
+        // and only redraw when the displayed time changes
+        using is_seqlock = void;
+        using is_change_detecting = void;
+
+        Model(bool twelve_hour_clock) {
+            this->twelve_hour_clock = twelve_hour_clock;
+        }
     };
 
     void OnEnter();
     void OnExit();
-    void OnTimeUpdate();
     bool OnInput(const InputEvent* event);
-    static void OnDraw(Canvas* canvas, const Model& model);
 
 private:
     void ShowLockScreen(bool show);
@@ -44,6 +57,7 @@ private:
 
 private:
     cookie::ViewModel<Model> m_view;
+    cookie::RedrawCoalescer m_redraw_coalescer;
 
     const uint32_t PREDIV_S;
 
@@ -58,7 +72,6 @@ private:
 
         // Returns true if input was consumed
         bool OnInput(const InputEvent* event);
-        static void OnDraw(Canvas* canvas, const Model& model);
 
         cookie::Task<bool> ProcessExitInputsAsync();
 
@@ -67,6 +80,7 @@ private:
 
     private:
         cookie::AwaitableTimer<cookie::FuriEventLoopTimer> m_lock_timer;
+        cookie::AwaitableInput m_back_presses;
         cookie::Task<bool> m_lock_task;
     };
     LockScreenOverlay m_lock_overlay;
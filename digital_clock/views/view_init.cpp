@@ -7,6 +7,7 @@
 
 #include <chrono>
 #include <cookie/common>
+#include <cookie/when>
 
 static constexpr uint32_t TEXT_SWITCH_PERIOD_MS = 1000;
 
@@ -28,7 +29,7 @@ InitView::InitView()
     view_set_input_callback(*m_view, [](InputEvent* event, void* context) {
         if(event->type == InputTypeShort && event->key == InputKeyOk) {
             InitView* view = reinterpret_cast<InitView*>(context);
-            view->m_splash_timer.wake_up(true);
+            view->m_skip_presses.dispatch(*event);
             return true;
         }
         return false;
@@ -47,23 +48,29 @@ void InitView::OnDraw(Canvas* canvas, const Model& model) {
     canvas_clear(canvas);
 
     const char* text_to_display = model.display_second_line ? "ALARM" : "FLIPPER";
-    const uint32_t text_width = SevenSegmentDisplay::DrawString(nullptr, text_to_display, 0, 0);
+    const uint32_t text_width = SevenSegmentDisplay::MeasureString(text_to_display);
 
+    canvas_set_bitmap_mode(canvas, true);
     SevenSegmentDisplay::DrawString(
         canvas,
         text_to_display,
         (128 - text_width) / 2,
         (64 - SevenSegmentDisplay::GetGlyphHeight()) / 2);
+    canvas_set_bitmap_mode(canvas, false);
 }
 
 cookie::Task<> InitView::ProcessSplashAsync() {
     using namespace std::chrono_literals;
 
-    // Don't bother updating the model if we skipped the wait
-    if(co_await m_splash_timer.await_delay(cookie::furi_chrono_duration_to_ticks(1s))) {
+    // Pressing OK skips the rest of the splash, so don't bother updating the model then
+    const uint32_t text_switch_ticks = cookie::furi_chrono_duration_to_ticks(1s);
+    auto first = co_await cookie::when_any(
+        m_splash_timer.await_delay(text_switch_ticks), m_skip_presses.next());
+    if(first.index() == 0) {
         cookie::with_view_model(*m_view, [](Model& model) { model.display_second_line = true; });
 
-        co_await m_splash_timer.await_delay(cookie::furi_chrono_duration_to_ticks(1s));
+        co_await cookie::when_any(
+            m_splash_timer.await_delay(text_switch_ticks), m_skip_presses.next());
     }
     get_outer()->SendAppEvent(AppLogicEvent::GoToNextScene);
 }
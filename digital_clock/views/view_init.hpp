@@ -3,6 +3,7 @@
 #include <cookie/coroutine>
 #include <cookie/event_loop>
 #include <cookie/within>
+#include <cookie/gui/input>
 #include <cookie/gui/view>
 
 class DigitalClockApp;
@@ -31,5 +32,6 @@ private:
 private:
     cookie::ViewModel<Model> m_view;
     cookie::AwaitableTimer<cookie::FuriEventLoopTimer> m_splash_timer;
+    cookie::AwaitableInput m_skip_presses;
     cookie::Task<> m_splash_task;
 };
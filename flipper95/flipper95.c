@@ -2,8 +2,11 @@
 #include <gui/gui.h>
 #include <input/input.h>
 #include <cli/cli.h>
+#include <storage/storage.h>
 #include <toolbox/args.h>
+#include <toolbox/crc32_calc.h>
 #include <toolbox/strint.h>
+#include <toolbox/stream/file_stream.h>
 
 #include <furi_hal_power.h>
 
@@ -13,10 +16,36 @@
 //#define MBEDTLS_CONFIG_FILE "mbedtls_cfg.h"
 #include <mbedtls/bignum.h>
 
+#include "util/decimal.h"
+#include "util/lucas_lehmer.h"
+#include "util/prime_sieve.h"
+
 #define CLI_COMMAND                     "flipper95"
 #define CLI_COMMAND_ADVANCE             "advance"
 #define CLI_COMMAND_LAST_PRIME          "prime"
 #define CLI_COMMAND_LAST_PERFECT_NUMBER "perfect_number"
+#define CLI_COMMAND_FACTORS             "factors"
+#define CLI_COMMAND_ERRORS              "errors"
+#define CLI_COMMAND_STATS               "stats"
+#define CLI_COMMAND_BENCH               "bench"
+
+// Every factor found by P-1 is appended to this file as an "M<p>: <factor>" line,
+// so they outlive the app and are never overwritten
+#define FACTORS_PATH APP_DATA_PATH("factors.txt")
+
+// About as many characters as fit on the screen, larger primes are abbreviated to their leading
+// and trailing digits. The full number is only ever converted when the CLI asks for it
+#define MPRIME_STR_SIZE 100
+
+// LL throughput and CPU usage are sampled, and the LL progress redrawn, this often
+#define TELEMETRY_SAMPLE_PERIOD_MS 1000
+#define TELEMETRY_SMOOTHING        0.25f // Weight of the newest throughput sample
+#define TELEMETRY_HISTORY_HOURS    24
+
+// The worker responds to input and redraws between slices of work this long
+#define SCHEDULER_SLICE_MS 20
+// Rounds of a Jacobi symbol or GCD between checks of the slice, each linear in the size of M_p
+#define JACOBI_ROUNDS_PER_STEP 16
 
 typedef struct {
     FuriPubSub* input;
@@ -24,14 +53,45 @@ typedef struct {
     Gui* gui;
     Canvas* canvas;
     CliRegistry* cli;
+    Storage* storage;
     FuriThreadList* thread_list;
 
-    // These are protected by the mutex
+    // These, and the factors file, are protected by the mutex
     FuriMutex* state_mutex;
     uint32_t cur_mnumber; // Current Mersenne number analyzed
     uint32_t cur_mprime; // Last Mersenne prime found
-    char* mprime_str;
-    size_t mprime_str_len;
+    char mprime_str[MPRIME_STR_SIZE];
+    uint32_t hardware_errors; // Residues that failed the error check
+    uint32_t error_check_ticks; // Total time spent on error checks
+    uint32_t start_tick;
+    uint32_t ll_mnumber; // Exponent under the LL test
+    uint32_t ll_iteration;
+    float iterations_per_second; // Smoothed LL throughput
+    uint32_t exponents_tested;
+    uint32_t history_hour; // Hours since start of the newest exponents_per_hour entry
+    uint16_t exponents_per_hour[TELEMETRY_HISTORY_HOURS]; // Ring buffer, indexed by the hour
+    uint32_t inputs_serviced;
+    uint32_t max_input_latency; // In ticks, from an input to the end of the slice it arrived in
+    uint32_t max_slice_ticks; // Longest time the worker went without a chance to respond to input
+
+    // Only accessed by the worker thread
+    uint32_t last_checkpoint_tick;
+    uint32_t checkpoint_period;
+    uint32_t resume_mnumber; // LL run to resume from the checkpoint
+    uint32_t resume_iteration;
+    mbedtls_mpi resume_residue;
+    uint32_t last_error_check_tick;
+    uint32_t error_check_period;
+    uint32_t telemetry_tick;
+    uint32_t telemetry_iterations; // LL iterations since the last telemetry sample
+    uint32_t cpu_usage_tick;
+    float cpu_usage;
+    uint32_t slice_tick;
+    int32_t mnumber_status_y; // Where the number under test and its LL progress are drawn
+    int32_t mnumber_status_width; // Width drawn there last, to erase it on the next redraw
+
+    atomic_bool error_checks_enabled;
+    atomic_uint_least32_t input_tick; // Oldest input not serviced by the worker yet, 0 if none
 
     atomic_uint_least8_t stop; // Bitmask, 1 = stop app, 2 = stop current number
 } Flipper95;
@@ -43,6 +103,15 @@ static void gui_input_events_callback(const void* value, void* ctx) {
     Flipper95* instance = ctx;
     const InputEvent* event = value;
 
+    if(event->type == InputTypePress) {
+        uint_least32_t no_input = 0;
+        atomic_compare_exchange_strong_explicit(
+            &instance->input_tick,
+            &no_input,
+            MAX(furi_get_tick(), 1u),
+            memory_order_relaxed,
+            memory_order_relaxed);
+    }
     if(event->key == InputKeyBack && event->type == InputTypeShort) {
         atomic_store_explicit(&instance->stop, 1, memory_order_relaxed);
     }
@@ -66,7 +135,12 @@ static void flipper95_cli_print_usage() {
         "Cmd list:\r\n"
         "\t" CLI_COMMAND_ADVANCE " M<p:int> - Advance calculations to a Mersenne number M_p\r\n"
         "\t" CLI_COMMAND_LAST_PRIME "\t\t - Print the last found Mersenne prime\r\n"
-        "\t" CLI_COMMAND_LAST_PERFECT_NUMBER "\t - Print the last found perfect number\r\n");
+        "\t" CLI_COMMAND_LAST_PERFECT_NUMBER "\t - Print the last found perfect number\r\n"
+        "\t" CLI_COMMAND_FACTORS "\t\t - Print all the factors found by P-1\r\n"
+        "\t" CLI_COMMAND_ERRORS " [on|off]\t - Print the detected hardware errors,\r\n"
+        "\t\t\t   optionally turning error checking on or off\r\n"
+        "\t" CLI_COMMAND_STATS "\t\t - Print the LL progress and throughput\r\n"
+        "\t" CLI_COMMAND_BENCH "\t\t - Run a fixed benchmark and print a comparable score\r\n");
 }
 
 static bool flipper95_cli_set_mnumber(const FuriString* args, Flipper95* instance) {
@@ -85,14 +159,54 @@ static bool flipper95_cli_set_mnumber(const FuriString* args, Flipper95* instanc
     return false;
 }
 
-static bool flipper95_cli_print_prime(const Flipper95* instance) {
+typedef struct {
+    PipeSide* pipe;
+    const Flipper95* instance;
+} Flipper95CliOutput;
+
+static bool flipper95_cli_output_digits(const char* digits, size_t len, void* context) {
+    const Flipper95CliOutput* output = context;
+    printf("%.*s", (int)len, digits);
+    furi_thread_stdout_flush();
+
+    // Ctrl+C or closing the app cancels the conversion
+    return !cli_is_pipe_broken_or_is_etx_next_char(output->pipe) &&
+           (atomic_load_explicit(&output->instance->stop, memory_order_relaxed) & 1) == 0;
+}
+
+// Prints X in decimal as the digits become available, so huge numbers never sit in RAM as a string
+static void
+    flipper95_cli_print_mpi(PipeSide* pipe, const Flipper95* instance, const mbedtls_mpi* X) {
+    Flipper95CliOutput output = {.pipe = pipe, .instance = instance};
+    if(!mpi_write_decimal_streamed(X, flipper95_cli_output_digits, &output)) {
+        printf("...\r\nCancelled");
+    }
+    printf("\r\n");
+}
+
+static bool flipper95_cli_print_prime(PipeSide* pipe, const Flipper95* instance) {
     furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
-    printf("M%lu = %s\r\n", instance->cur_mprime, instance->mprime_str);
+    const uint32_t last_prime = instance->cur_mprime;
     furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+
+    printf("M%lu = ", last_prime);
+    if(last_prime == 0) {
+        printf("\r\n");
+        return true;
+    }
+
+    mbedtls_mpi M_p;
+    mbedtls_mpi_init(&M_p);
+    mersenne_number(&M_p, last_prime);
+
+    flipper95_cli_print_mpi(pipe, instance, &M_p);
+
+    mbedtls_mpi_free(&M_p);
+
     return true;
 }
 
-static bool flipper95_cli_print_perfect_number(const Flipper95* instance) {
+static bool flipper95_cli_print_perfect_number(PipeSide* pipe, const Flipper95* instance) {
     furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
     const uint32_t last_prime = instance->cur_mprime;
     furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
@@ -110,24 +224,235 @@ static bool flipper95_cli_print_perfect_number(const Flipper95* instance) {
     mbedtls_mpi_sub_int(&M_p, &M_p, 1); // 2^p - 1
 
     mbedtls_mpi_mul_mpi(&M_p, &M_p, &Two_p);
+    mbedtls_mpi_free(&Two_p);
 
-    // Allocate space
-    size_t space_needed = 0;
-    mbedtls_mpi_write_string(&M_p, 10, NULL, 0, &space_needed);
+    printf("Perfect%lu = ", last_prime);
+    flipper95_cli_print_mpi(pipe, instance, &M_p);
 
-    char* buffer = malloc(space_needed);
-    furi_check(mbedtls_mpi_write_string(&M_p, 10, buffer, space_needed, &space_needed) == 0);
-    printf("Perfect%lu = %s\r\n", last_prime, buffer);
-    free(buffer);
+    mbedtls_mpi_free(&M_p);
 
-    mbedtls_mpi_free(&Two_p);
+    return true;
+}
+
+static bool flipper95_cli_print_factors(const Flipper95* instance) {
+    FuriString* line = furi_string_alloc();
+    uint32_t factors_found = 0;
+
+    furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
+    Stream* stream = file_stream_alloc(instance->storage);
+    if(file_stream_open(stream, FACTORS_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        while(stream_read_line(stream, line)) {
+            furi_string_trim(line, "\r\n");
+            printf("%s\r\n", furi_string_get_cstr(line));
+            factors_found++;
+        }
+    }
+    file_stream_close(stream);
+    stream_free(stream);
+    furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+
+    printf("P-1 found %lu factor(s)\r\n", factors_found);
+    furi_string_free(line);
+    return true;
+}
+
+static bool flipper95_cli_errors(FuriString* args, Flipper95* instance) {
+    if(furi_string_size(args) != 0) {
+        if(furi_string_equal(args, "on")) {
+            atomic_store_explicit(&instance->error_checks_enabled, true, memory_order_relaxed);
+        } else if(furi_string_equal(args, "off")) {
+            atomic_store_explicit(&instance->error_checks_enabled, false, memory_order_relaxed);
+        } else {
+            return false;
+        }
+    }
+
+    furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
+    const uint32_t hardware_errors = instance->hardware_errors;
+    const uint32_t error_check_ticks = instance->error_check_ticks;
+    furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+
+    const uint32_t total_ticks = MAX(furi_get_tick() - instance->start_tick, 1u);
+    printf(
+        "Error checking: %s\r\nHardware errors: %lu\r\nOverhead: %.2f%%\r\n",
+        atomic_load_explicit(&instance->error_checks_enabled, memory_order_relaxed) ? "on" : "off",
+        hardware_errors,
+        (double)error_check_ticks * 100.0 / total_ticks);
+    return true;
+}
+
+static uint32_t flipper95_hours_since_start(const Flipper95* instance) {
+    return (furi_get_tick() - instance->start_tick) / furi_ms_to_ticks(60 * 60 * 1000);
+}
+
+static bool flipper95_cli_print_stats(const Flipper95* instance) {
+    furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
+    const uint32_t ll_mnumber = instance->ll_mnumber;
+    const uint32_t ll_iteration = instance->ll_iteration;
+    const float iterations_per_second = instance->iterations_per_second;
+    const uint32_t exponents_tested = instance->exponents_tested;
+    const uint32_t history_hour = instance->history_hour;
+    uint16_t exponents_per_hour[TELEMETRY_HISTORY_HOURS];
+    memcpy(exponents_per_hour, instance->exponents_per_hour, sizeof(exponents_per_hour));
+    const uint32_t inputs_serviced = instance->inputs_serviced;
+    const uint32_t max_input_latency = instance->max_input_latency;
+    const uint32_t max_slice_ticks = instance->max_slice_ticks;
+    furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+
+    const uint32_t tick_frequency = furi_kernel_get_tick_frequency();
+
+    if(ll_mnumber > 2) {
+        const uint32_t iterations = ll_mnumber - 2;
+        printf(
+            "Testing M%lu: %lu/%lu iterations (%.1f%%)\r\n",
+            ll_mnumber,
+            ll_iteration,
+            iterations,
+            (double)ll_iteration * 100.0 / iterations);
+        if(iterations_per_second > 0.0f) {
+            const uint32_t eta = (iterations - ll_iteration) / iterations_per_second;
+            printf(
+                "%.1f iterations/s, %.3f ms/iteration, ETA %lu:%02lu:%02lu\r\n",
+                (double)iterations_per_second,
+                1000.0 / (double)iterations_per_second,
+                eta / 3600,
+                eta / 60 % 60,
+                eta % 60);
+        }
+    }
+
+    const uint32_t elapsed = (furi_get_tick() - instance->start_tick) / tick_frequency;
+    printf(
+        "Tested %lu exponents in %lu:%02lu:%02lu (%.1f per hour)\r\n",
+        exponents_tested,
+        elapsed / 3600,
+        elapsed / 60 % 60,
+        elapsed % 60,
+        (double)exponents_tested * 3600.0 / MAX(elapsed, 1u));
+
+    // Hours with no exponents tested yet aren't in the ring buffer
+    const uint32_t hour = flipper95_hours_since_start(instance);
+    printf("Exponents tested per hour, most recent first:");
+    for(uint32_t i = 0; i < TELEMETRY_HISTORY_HOURS && i <= hour; i++) {
+        const uint32_t entry_hour = hour - i;
+        printf(
+            " %u",
+            entry_hour <= history_hour ?
+                exponents_per_hour[entry_hour % TELEMETRY_HISTORY_HOURS] :
+                0);
+    }
+    printf("\r\n");
+
+    printf(
+        "Worst input latency: %lums over %lu inputs, longest slice %lums of %dms\r\n",
+        (uint32_t)((uint64_t)max_input_latency * 1000 / tick_frequency),
+        inputs_serviced,
+        (uint32_t)((uint64_t)max_slice_ticks * 1000 / tick_frequency),
+        SCHEDULER_SLICE_MS);
+    return true;
+}
+
+// Fixed workloads to compare devices, firmware builds and battery states: LL iterations
+// at a few exponent sizes and the prime pre-check. The score is the geometric mean of the work
+// done per second, with LL iterations weighted by their quadratic cost relative to 1024 bits.
+// It runs on its own numbers, so the search and its checkpoint are left alone.
+#define BENCH_PRECHECK_START 1000000
+#define BENCH_PRECHECK_COUNT 1000000
+#define BENCH_RESIDUE_MOD    0x7FFFFFFF // Residues are printed modulo 2^31 - 1
+
+typedef struct {
+    uint32_t p;
+    uint32_t iterations;
+} Flipper95BenchWorkload;
+
+static const Flipper95BenchWorkload bench_workloads[] = {
+    {1021, 2000},
+    {4093, 200},
+    {16381, 20},
+};
+
+static bool flipper95_bench_cancelled(PipeSide* pipe, const Flipper95* instance) {
+    return cli_is_pipe_broken_or_is_etx_next_char(pipe) ||
+           (atomic_load_explicit(&instance->stop, memory_order_relaxed) & 1) != 0;
+}
+
+static uint32_t flipper95_bench_elapsed_ms(uint32_t start_tick) {
+    const uint32_t ms = (uint64_t)(furi_get_tick() - start_tick) * 1000 /
+                        furi_kernel_get_tick_frequency();
+    return MAX(ms, 1u);
+}
+
+static bool flipper95_cli_bench(PipeSide* pipe, const Flipper95* instance) {
+    mbedtls_mpi M_p, S, temp;
+    mbedtls_mpi_init(&M_p);
+    mbedtls_mpi_init(&S);
+    mbedtls_mpi_init(&temp);
+
+    float log_score = 0.0f;
+    bool cancelled = false;
+    for(size_t i = 0; i < COUNT_OF(bench_workloads) && !cancelled; i++) {
+        const Flipper95BenchWorkload* workload = &bench_workloads[i];
+        mersenne_number(&M_p, workload->p);
+        mbedtls_mpi_lset(&S, 4);
+
+        const uint32_t start_tick = furi_get_tick();
+        for(uint32_t iteration = 0; iteration < workload->iterations && !cancelled; iteration++) {
+            lucas_lehmer_step(&S, &M_p, &temp);
+            cancelled = flipper95_bench_cancelled(pipe, instance);
+        }
+        if(cancelled) {
+            break;
+        }
+        const uint32_t ms = flipper95_bench_elapsed_ms(start_tick);
+
+        // Identical on every device, a mismatch means broken arithmetic
+        mbedtls_mpi_uint residue = 0;
+        mbedtls_mpi_mod_int(&residue, &S, BENCH_RESIDUE_MOD);
+
+        const float work = (float)workload->iterations * workload->p * workload->p / (1024 * 1024);
+        log_score += logf(work * 1000.0f / ms);
+        printf(
+            "bench ll p=%lu iterations=%lu ms=%lu us_per_iteration=%lu residue=%lu\r\n",
+            workload->p,
+            workload->iterations,
+            ms,
+            (uint32_t)((uint64_t)ms * 1000 / workload->iterations),
+            (uint32_t)residue);
+    }
+
+    mbedtls_mpi_free(&temp);
+    mbedtls_mpi_free(&S);
     mbedtls_mpi_free(&M_p);
 
+    if(!cancelled) {
+        PrimeSieve* sieve = prime_sieve_alloc();
+        const uint32_t start_tick = furi_get_tick();
+        uint32_t primes = 0;
+        for(uint32_t n = prime_sieve_next(sieve, BENCH_PRECHECK_START);
+            n < BENCH_PRECHECK_START + BENCH_PRECHECK_COUNT;
+            n = prime_sieve_next(sieve, n + 1)) {
+            primes++;
+        }
+        const uint32_t ms = flipper95_bench_elapsed_ms(start_tick);
+        prime_sieve_free(sieve);
+
+        // Thousands of candidates per second
+        log_score += logf((float)BENCH_PRECHECK_COUNT / ms);
+        printf(
+            "bench precheck candidates=%d primes=%lu ms=%lu\r\n",
+            BENCH_PRECHECK_COUNT,
+            primes,
+            ms);
+        printf(
+            "bench score=%.2f\r\n",
+            (double)expf(log_score / (COUNT_OF(bench_workloads) + 1)));
+    } else {
+        printf("bench cancelled\r\n");
+    }
     return true;
 }
 
 static void flipper95_cli_callback(PipeSide* pipe, FuriString* args, void* context) {
-    UNUSED(pipe);
     Flipper95* instance = context;
 
     FuriString* cmd = furi_string_alloc();
@@ -136,9 +461,17 @@ static void flipper95_cli_callback(PipeSide* pipe, FuriString* args, void* conte
         if(furi_string_equal(cmd, CLI_COMMAND_ADVANCE)) {
             success = flipper95_cli_set_mnumber(args, instance);
         } else if(furi_string_equal(cmd, CLI_COMMAND_LAST_PRIME)) {
-            success = flipper95_cli_print_prime(instance);
+            success = flipper95_cli_print_prime(pipe, instance);
         } else if(furi_string_equal(cmd, CLI_COMMAND_LAST_PERFECT_NUMBER)) {
-            success = flipper95_cli_print_perfect_number(instance);
+            success = flipper95_cli_print_perfect_number(pipe, instance);
+        } else if(furi_string_equal(cmd, CLI_COMMAND_FACTORS)) {
+            success = flipper95_cli_print_factors(instance);
+        } else if(furi_string_equal(cmd, CLI_COMMAND_ERRORS)) {
+            success = flipper95_cli_errors(args, instance);
+        } else if(furi_string_equal(cmd, CLI_COMMAND_STATS)) {
+            success = flipper95_cli_print_stats(instance);
+        } else if(furi_string_equal(cmd, CLI_COMMAND_BENCH)) {
+            success = flipper95_cli_bench(pipe, instance);
         }
     }
 
@@ -149,12 +482,235 @@ static void flipper95_cli_callback(PipeSide* pipe, FuriString* args, void* conte
 }
 
 static float flipper95_get_cpu_usage(Flipper95* instance) {
-    if(furi_thread_enumerate(instance->thread_list)) {
+    // Enumerating threads is expensive, and small exponents are tested many times per second
+    const uint32_t tick = furi_get_tick();
+    if(tick - instance->cpu_usage_tick >= furi_ms_to_ticks(TELEMETRY_SAMPLE_PERIOD_MS) &&
+       furi_thread_enumerate(instance->thread_list)) {
         const FuriThreadListItem* thread_metrics =
             furi_thread_list_get_or_insert(instance->thread_list, furi_thread_get_current());
-        return CLAMP(thread_metrics->cpu, 100.0f, 0.0f);
+        instance->cpu_usage = CLAMP(thread_metrics->cpu, 100.0f, 0.0f);
+        instance->cpu_usage_tick = tick;
+    }
+    return instance->cpu_usage;
+}
+
+static bool flipper95_slice_elapsed(const Flipper95* instance) {
+    return furi_get_tick() - instance->slice_tick >= furi_ms_to_ticks(SCHEDULER_SLICE_MS);
+}
+
+// Ends the current slice of work. Returns true if input arrived during it, so the screen can respond
+static bool flipper95_end_slice(Flipper95* instance) {
+    const uint32_t slice_ticks = furi_get_tick() - instance->slice_tick;
+    furi_thread_yield();
+
+    const uint32_t tick = furi_get_tick();
+    instance->slice_tick = tick;
+    const uint32_t input_tick =
+        atomic_exchange_explicit(&instance->input_tick, 0, memory_order_relaxed);
+    // Only the worker writes max_slice_ticks, so it can be read without the mutex
+    if(input_tick == 0 && slice_ticks <= instance->max_slice_ticks) {
+        return false;
+    }
+
+    furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
+    instance->max_slice_ticks = MAX(instance->max_slice_ticks, slice_ticks);
+    if(input_tick != 0) {
+        instance->inputs_serviced++;
+        instance->max_input_latency = MAX(instance->max_input_latency, tick - input_tick);
+    }
+    furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+    return input_tick != 0;
+}
+
+// Draws the number under test right aligned, followed by the LL progress once there is some,
+// over whatever was drawn there before
+static void flipper95_draw_mnumber_status(Flipper95* instance, uint32_t p, uint32_t iteration) {
+    char buffer[32];
+    size_t len = 0;
+    if(instance->hardware_errors != 0) {
+        len = snprintf(buffer, sizeof(buffer), "E:%lu ", instance->hardware_errors);
+    }
+    len += snprintf(buffer + len, sizeof(buffer) - len, ">M%lu", p);
+    if(iteration != 0) {
+        const uint32_t percent = (uint64_t)iteration * 100 / (p - 2);
+        snprintf(buffer + len, sizeof(buffer) - len, " %lu%%", percent);
+    }
+
+    const int32_t y = instance->mnumber_status_y;
+    const int32_t width = canvas_string_width(instance->canvas, buffer);
+    const int32_t box_width = MAX(width, instance->mnumber_status_width);
+    canvas_set_color(instance->canvas, ColorWhite);
+    canvas_draw_box(instance->canvas, 128 - box_width, y, box_width, 8);
+    canvas_set_color(instance->canvas, ColorBlack);
+    canvas_draw_str_aligned(instance->canvas, 128, y, AlignRight, AlignTop, buffer);
+    canvas_commit(instance->canvas);
+    instance->mnumber_status_width = width;
+}
+
+// Everything that can run for longer than a slice calls this regularly, so input is responded to
+// on time no matter what the worker is busy with
+static void flipper95_service_slice(Flipper95* instance, uint32_t p, uint32_t iteration) {
+    if(flipper95_slice_elapsed(instance) && flipper95_end_slice(instance)) {
+        flipper95_draw_mnumber_status(instance, p, iteration);
     }
-    return 0.0f;
+}
+
+// Checkpoints of the LL progress, so long runs survive the app exiting, reboots and dead batteries.
+// Written to a temporary file first and then renamed over the old checkpoint, with a CRC32 at the end.
+#define CHECKPOINT_PATH          APP_DATA_PATH("checkpoint.bin")
+#define CHECKPOINT_TMP_PATH      APP_DATA_PATH("checkpoint.tmp")
+#define CHECKPOINT_MAGIC         0x35394643 // CF95
+#define CHECKPOINT_VERSION       1
+#define CHECKPOINT_MIN_PERIOD_MS (30 * 1000)
+#define CHECKPOINT_COST_RATIO    100 // Writing checkpoints takes at most 1% of the runtime
+// The LL state of larger exponents doesn't fit in RAM anyway, so anything above is a corrupt header
+#define CHECKPOINT_MAX_MNUMBER   (512 * 1024)
+#define CHECKPOINT_CHUNK_BYTES   1024 // The residue is written this much at a time, between slices
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t mnumber; // Exponent under test
+    uint32_t iteration; // LL iterations completed, 0 means the residue is not stored
+    uint32_t last_mprime;
+    uint32_t residue_size; // Residue bytes (little endian) following the header
+} Flipper95CheckpointHeader;
+
+static void flipper95_set_mprime_str(Flipper95* instance, uint32_t p) {
+    mersenne_to_decimal_abbreviated(p, instance->mprime_str, sizeof(instance->mprime_str));
+}
+
+static bool flipper95_checkpoint_due(const Flipper95* instance) {
+    return furi_get_tick() - instance->last_checkpoint_tick >= instance->checkpoint_period;
+}
+
+// Residue may be NULL if iteration is 0
+static bool flipper95_save_checkpoint(
+    Flipper95* instance,
+    uint32_t mnumber,
+    uint32_t iteration,
+    const mbedtls_mpi* residue) {
+    const uint32_t start_tick = furi_get_tick();
+
+    Flipper95CheckpointHeader header = {
+        .magic = CHECKPOINT_MAGIC,
+        .version = CHECKPOINT_VERSION,
+        .mnumber = mnumber,
+        .iteration = iteration,
+        .residue_size = iteration != 0 ? (mnumber + 7) / 8 : 0,
+    };
+    furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
+    header.last_mprime = instance->cur_mprime;
+    furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+
+    uint8_t* residue_buf = NULL;
+    if(header.residue_size != 0) {
+        residue_buf = malloc(header.residue_size);
+        furi_check(mbedtls_mpi_write_binary_le(residue, residue_buf, header.residue_size) == 0);
+    }
+    uint32_t crc = crc32_calc_buffer(0, &header, sizeof(header));
+
+    File* file = storage_file_alloc(instance->storage);
+    bool success = false;
+    if(storage_file_open(file, CHECKPOINT_TMP_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        success = storage_file_write(file, &header, sizeof(header)) == sizeof(header);
+        for(uint32_t offset = 0; success && offset < header.residue_size;
+            offset += CHECKPOINT_CHUNK_BYTES) {
+            const uint32_t len =
+                MIN(header.residue_size - offset, (uint32_t)CHECKPOINT_CHUNK_BYTES);
+            crc = crc32_calc_buffer(crc, residue_buf + offset, len);
+            success = storage_file_write(file, residue_buf + offset, len) == len;
+            flipper95_service_slice(instance, mnumber, iteration);
+        }
+        success = success && storage_file_write(file, &crc, sizeof(crc)) == sizeof(crc);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+    free(residue_buf);
+
+    // If we die between these two, loading picks up the temporary file instead
+    if(success) {
+        storage_common_remove(instance->storage, CHECKPOINT_PATH);
+        success = storage_common_rename(instance->storage, CHECKPOINT_TMP_PATH, CHECKPOINT_PATH) ==
+                  FSE_OK;
+    }
+
+    // Space out the checkpoints so writing them never takes more than a small fraction of the runtime,
+    // no matter how slow the SD card and how long the LL iterations are
+    instance->last_checkpoint_tick = furi_get_tick();
+    instance->checkpoint_period = MAX(
+        furi_ms_to_ticks(CHECKPOINT_MIN_PERIOD_MS),
+        (instance->last_checkpoint_tick - start_tick) * CHECKPOINT_COST_RATIO);
+    return success;
+}
+
+static bool flipper95_load_checkpoint_file(Flipper95* instance, const char* path) {
+    File* file = storage_file_alloc(instance->storage);
+    Flipper95CheckpointHeader header;
+    uint8_t* residue_buf = NULL;
+    bool success = false;
+    do {
+        if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != CHECKPOINT_MAGIC || header.version != CHECKPOINT_VERSION) break;
+        if(header.mnumber < 2 || header.mnumber > CHECKPOINT_MAX_MNUMBER) break;
+        if(header.iteration > header.mnumber - 2) break;
+        if(header.residue_size != (header.iteration != 0 ? (header.mnumber + 7) / 8 : 0)) break;
+        // Catch truncated files before allocating anything for them
+        if(storage_file_size(file) !=
+           sizeof(header) + header.residue_size + sizeof(uint32_t)) {
+            break;
+        }
+
+        residue_buf = malloc(header.residue_size);
+        uint32_t crc;
+        if(storage_file_read(file, residue_buf, header.residue_size) != header.residue_size) break;
+        if(storage_file_read(file, &crc, sizeof(crc)) != sizeof(crc)) break;
+
+        uint32_t expected_crc = crc32_calc_buffer(0, &header, sizeof(header));
+        expected_crc = crc32_calc_buffer(expected_crc, residue_buf, header.residue_size);
+        if(crc != expected_crc) break;
+
+        if(header.iteration != 0) {
+            furi_check(
+                mbedtls_mpi_read_binary_le(
+                    &instance->resume_residue, residue_buf, header.residue_size) == 0);
+        }
+        instance->resume_mnumber = header.mnumber;
+        instance->resume_iteration = header.iteration;
+        instance->cur_mnumber = header.mnumber;
+        instance->cur_mprime = header.last_mprime;
+        success = true;
+    } while(false);
+
+    free(residue_buf);
+    storage_file_close(file);
+    storage_file_free(file);
+    return success;
+}
+
+static void flipper95_load_checkpoint(Flipper95* instance) {
+    if(!flipper95_load_checkpoint_file(instance, CHECKPOINT_PATH) &&
+       !flipper95_load_checkpoint_file(instance, CHECKPOINT_TMP_PATH)) {
+        return;
+    }
+
+    if(instance->cur_mprime != 0) {
+        flipper95_set_mprime_str(instance, instance->cur_mprime);
+    }
+}
+
+// If the checkpoint saved a partial LL run of M_p, restores S to it and returns the iteration to continue from
+static uint32_t flipper95_take_resume_state(Flipper95* instance, uint32_t p, mbedtls_mpi* S) {
+    uint32_t iteration = 0;
+    if(instance->resume_mnumber == p && instance->resume_iteration != 0) {
+        mbedtls_mpi_swap(S, &instance->resume_residue);
+        iteration = instance->resume_iteration;
+    }
+    instance->resume_mnumber = 0;
+    instance->resume_iteration = 0;
+    mbedtls_mpi_free(&instance->resume_residue);
+    return iteration;
 }
 
 static void flipper95_init(Flipper95* instance) {
@@ -162,6 +718,7 @@ static void flipper95_init(Flipper95* instance) {
     instance->gui = furi_record_open(RECORD_GUI);
     instance->canvas = gui_direct_draw_acquire(instance->gui);
     instance->cli = furi_record_open(RECORD_CLI);
+    instance->storage = furi_record_open(RECORD_STORAGE);
 
     instance->input_subscription =
         furi_pubsub_subscribe(instance->input, gui_input_events_callback, instance);
@@ -171,39 +728,456 @@ static void flipper95_init(Flipper95* instance) {
     instance->state_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     instance->cur_mnumber = 2;
     instance->cur_mprime = 0;
-    instance->mprime_str_len = 256;
-    instance->mprime_str = malloc(instance->mprime_str_len);
     instance->mprime_str[0] = '\0';
 
+    instance->last_checkpoint_tick = furi_get_tick();
+    instance->checkpoint_period = furi_ms_to_ticks(CHECKPOINT_MIN_PERIOD_MS);
+    instance->resume_mnumber = 0;
+    instance->resume_iteration = 0;
+    mbedtls_mpi_init(&instance->resume_residue);
+    flipper95_load_checkpoint(instance);
+
+    instance->hardware_errors = 0;
+    instance->error_check_ticks = 0;
+    instance->start_tick = furi_get_tick();
+    instance->last_error_check_tick = instance->start_tick;
+    instance->error_check_period = 0;
+
+    instance->ll_mnumber = 0;
+    instance->ll_iteration = 0;
+    instance->iterations_per_second = 0.0f;
+    instance->exponents_tested = 0;
+    instance->history_hour = 0;
+    memset(instance->exponents_per_hour, 0, sizeof(instance->exponents_per_hour));
+    instance->telemetry_tick = instance->start_tick;
+    instance->telemetry_iterations = 0;
+    instance->cpu_usage_tick = instance->start_tick - furi_ms_to_ticks(TELEMETRY_SAMPLE_PERIOD_MS);
+    instance->cpu_usage = 0.0f;
+
+    instance->inputs_serviced = 0;
+    instance->max_input_latency = 0;
+    instance->max_slice_ticks = 0;
+    instance->slice_tick = instance->start_tick;
+    instance->mnumber_status_y = 0;
+    instance->mnumber_status_width = 0;
+    atomic_init(&instance->input_tick, 0);
+
+    atomic_init(&instance->error_checks_enabled, true);
     atomic_init(&instance->stop, 0);
 }
 
 static void flipper95_deinit(Flipper95* instance) {
-    free(instance->mprime_str);
+    mbedtls_mpi_free(&instance->resume_residue);
     furi_mutex_free(instance->state_mutex);
 
     furi_thread_list_free(instance->thread_list);
 
     furi_pubsub_unsubscribe(instance->input, instance->input_subscription);
 
+    furi_record_close(RECORD_STORAGE);
     furi_record_close(RECORD_CLI);
     gui_direct_draw_release(instance->gui);
     furi_record_close(RECORD_GUI);
     furi_record_close(RECORD_INPUT_EVENTS);
 }
 
-bool trial_division_is_prime(uint32_t n) {
-    if(n == 2) return true;
-    if((n % 2) == 0) return false;
-    const uint32_t sqrt_n = (unsigned int)sqrt((double)n);
-    for(uint32_t x = 3; x <= sqrt_n; x += 2) {
-        if((n % x) == 0) {
+// Pollard P-1 factoring, ran before the LL test to cheaply weed out Mersenne numbers
+// with a factor q = 2kp + 1, where k is B1-smooth (save for at most one prime factor up to B2).
+// All the modular arithmetic is the same as in the LL test - a full multiplication followed by mersenne_reduce.
+// Below P1_MIN_EXPONENT, LL is cheaper than even choosing the bounds.
+// P1_MAX_FACTOR_BITS limits the factor sizes considered when estimating the success probability.
+// Costs are expressed in modular squarings:
+// * stage 1 takes ~1.44 squarings and ~0.72 multiplications per unit of B1
+// * stage 2 takes a multiplication into the accumulator and ~1.5 to step to the next prime,
+//   using the precomputed x^2, x^4, x^6, x^8
+#define P1_MIN_EXPONENT             1000
+#define P1_MAX_FACTOR_BITS          128
+#define P1_STAGE2_INTEGRATION_STEPS 8
+#define P1_STAGE2_B2_MULTIPLIER     20
+#define P1_STAGE2_GAP_TABLE_SIZE    4
+#define P1_STAGE1_COST_PER_B1       2.16f
+#define P1_STAGE2_COST_PER_PRIME    2.5f
+#define P1_GCD_COST                 20.0f
+#define P1_BOUNDS_BUCKET_BITS       5 // Bounds are chosen once per 1/16th of an octave of exponents
+
+typedef struct {
+    uint32_t B1; // 0 if P-1 is not worth running
+    uint32_t B2; // Equal to B1 if stage 2 is not worth running
+} P1Bounds;
+
+typedef struct {
+    uint32_t bucket_start; // 0 if nothing is cached yet
+    P1Bounds bounds;
+} P1BoundsCache;
+
+// Dickman's rho function, exact up to u = 2 and log-interpolated between known values past that
+static float dickman_rho(float u) {
+    static const float rho_table[] = {
+        1.0f,
+        1.0f,
+        3.0685282e-1f,
+        4.8608388e-2f,
+        4.9109256e-3f,
+        3.5472470e-4f,
+        1.9649696e-5f,
+        8.7456700e-7f,
+        3.2320693e-8f,
+        1.0162483e-9f,
+        2.7701718e-11f,
+    };
+    if(u <= 1.0f) return 1.0f;
+    if(u <= 2.0f) return 1.0f - logf(u);
+    if(u >= COUNT_OF(rho_table) - 1) return 0.0f;
+
+    const uint32_t i = (uint32_t)u;
+    const float frac = u - i;
+    return expf(logf(rho_table[i]) * (1.0f - frac) + logf(rho_table[i + 1]) * frac);
+}
+
+static float p1_success_probability(uint32_t p, uint32_t B1, uint32_t B2) {
+    const float log_B1 = logf(B1);
+    const float log_B2 = logf(B2);
+    const float log_2p = logf(2.0f * p);
+    const float stage2_step = (log_B2 - log_B1) / P1_STAGE2_INTEGRATION_STEPS;
+
+    // M_p has a factor between 2^b and 2^(b+1) with a probability of roughly 1/b
+    float prob_no_factor = 1.0f;
+    for(uint32_t bits = 2; bits < P1_MAX_FACTOR_BITS; bits++) {
+        const float log_k = bits * (float)M_LN2 - log_2p;
+        if(log_k <= 0.0f) {
+            continue;
+        }
+
+        float prob_smooth = dickman_rho(log_k / log_B1);
+        if(B2 > B1) {
+            // k = s * q, where s is B1-smooth and q is a prime in (B1, B2]
+            for(uint32_t i = 0; i < P1_STAGE2_INTEGRATION_STEPS; i++) {
+                const float log_q = log_B1 + (i + 0.5f) * stage2_step;
+                if(log_q >= log_k) {
+                    break;
+                }
+                prob_smooth += dickman_rho((log_k - log_q) / log_B1) * stage2_step / log_q;
+            }
+        }
+        prob_no_factor *= 1.0f - MIN(prob_smooth, 1.0f) / bits;
+    }
+    return 1.0f - prob_no_factor;
+}
+
+// Cost of P-1 and LL tests expressed in modular squarings of M_p
+static float p1_cost(uint32_t B1, uint32_t B2) {
+    float cost = B1 * P1_STAGE1_COST_PER_B1 + P1_GCD_COST;
+    if(B2 > B1) {
+        const float num_stage2_primes = B2 / logf(B2) - B1 / logf(B1);
+        cost += num_stage2_primes * P1_STAGE2_COST_PER_PRIME + P1_GCD_COST;
+    }
+    return cost;
+}
+
+// Pick the bounds that maximize the expected savings, like Prime95 does
+static P1Bounds p1_choose_bounds(uint32_t p) {
+    static const uint32_t B1_candidates[] = {
+        100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, 1000000};
+
+    P1Bounds result = {0, 0};
+    if(p < P1_MIN_EXPONENT) {
+        return result;
+    }
+
+    const float ll_cost = p - 2;
+    float best_savings = 0.0f;
+    for(size_t i = 0; i < COUNT_OF(B1_candidates); i++) {
+        const uint32_t B1 = B1_candidates[i];
+        if(B1 * P1_STAGE1_COST_PER_B1 >= ll_cost) {
+            break;
+        }
+
+        const uint32_t B2_candidates[] = {B1, B1 * P1_STAGE2_B2_MULTIPLIER};
+        for(size_t j = 0; j < COUNT_OF(B2_candidates); j++) {
+            const uint32_t B2 = B2_candidates[j];
+            const float savings = p1_success_probability(p, B1, B2) * ll_cost - p1_cost(B1, B2);
+            if(savings > best_savings) {
+                best_savings = savings;
+                result.B1 = B1;
+                result.B2 = B2;
+            }
+        }
+    }
+    return result;
+}
+
+// Choosing the bounds takes thousands of logf and expf calls, but they barely change between
+// neighbouring exponents. Exponents sharing their top P1_BOUNDS_BUCKET_BITS bits share the bounds,
+// chosen for the smallest exponent of the bucket.
+static P1Bounds p1_choose_bounds_cached(P1BoundsCache* cache, uint32_t p) {
+    if(p < P1_MIN_EXPONENT) {
+        return (P1Bounds){0, 0};
+    }
+
+    const uint32_t shift = 32 - __builtin_clz(p) - P1_BOUNDS_BUCKET_BITS;
+    const uint32_t bucket_start = (p >> shift) << shift;
+    if(cache->bucket_start != bucket_start) {
+        cache->bucket_start = bucket_start;
+        cache->bounds = p1_choose_bounds(MAX(bucket_start, (uint32_t)P1_MIN_EXPONENT));
+    }
+    return cache->bounds;
+}
+
+static bool flipper95_should_stop(const Flipper95* instance) {
+    return atomic_load_explicit(&instance->stop, memory_order_relaxed) != 0;
+}
+
+// P-1 runs its arithmetic in slices like the LL test, and shares its state
+typedef struct {
+    Flipper95* instance;
+    uint32_t p;
+    const mbedtls_mpi* M_p;
+    LucasLehmerSlicedStep* step;
+    MpiJacobi* jacobi;
+    mbedtls_mpi* temp;
+} P1Context;
+
+// X = X * B % M_p. Returns false if the app is stopping, X is left untouched then
+static bool p1_mul_mod(const P1Context* ctx, mbedtls_mpi* X, const mbedtls_mpi* B) {
+    while(!mersenne_sliced_mul_mod(ctx->step, X, B, ctx->M_p, ctx->temp)) {
+        if(flipper95_should_stop(ctx->instance)) {
+            lucas_lehmer_sliced_step_reset(ctx->step);
             return false;
         }
+        flipper95_service_slice(ctx->instance, ctx->p, 0);
     }
+    flipper95_service_slice(ctx->instance, ctx->p, 0);
     return true;
 }
 
+// X = X^e % M_p, left-to-right binary exponentiation. Returns false if the app is stopping
+static bool p1_pow_mod(const P1Context* ctx, mbedtls_mpi* X, uint32_t e, mbedtls_mpi* base) {
+    mbedtls_mpi_copy(base, X);
+    for(int32_t bit = 30 - __builtin_clz(e); bit >= 0; bit--) {
+        if(!p1_mul_mod(ctx, X, X)) {
+            return false;
+        }
+        if((e & (1u << bit)) != 0 && !p1_mul_mod(ctx, X, base)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns true if gcd(A, M_p) is a proper factor of M_p, and puts it in factor.
+// Returns false if the app is stopping
+static bool p1_gcd_has_factor(const P1Context* ctx, mbedtls_mpi* factor, const mbedtls_mpi* A) {
+    mpi_jacobi_start(ctx->jacobi, A, ctx->M_p);
+    while(!mpi_jacobi_continue(ctx->jacobi, JACOBI_ROUNDS_PER_STEP)) {
+        if(flipper95_should_stop(ctx->instance)) {
+            return false;
+        }
+        flipper95_service_slice(ctx->instance, ctx->p, 0);
+    }
+    mbedtls_mpi_copy(factor, &ctx->jacobi->n);
+    return mbedtls_mpi_cmp_int(factor, 1) > 0 && mbedtls_mpi_cmp_mpi(factor, ctx->M_p) < 0;
+}
+
+// Returns true and puts the factor in factor if one was found
+static bool flipper95_p1_factor(
+    Flipper95* instance,
+    uint32_t p,
+    P1Bounds bounds,
+    const mbedtls_mpi* M_p,
+    LucasLehmerSlicedStep* step,
+    MpiJacobi* jacobi,
+    mbedtls_mpi* factor,
+    mbedtls_mpi* temp) {
+    const P1Context ctx = {
+        .instance = instance,
+        .p = p,
+        .M_p = M_p,
+        .step = step,
+        .jacobi = jacobi,
+        .temp = temp,
+    };
+    mbedtls_mpi x, base;
+    mbedtls_mpi_init(&x);
+    mbedtls_mpi_init(&base);
+    PrimeSieve* primes = prime_sieve_alloc();
+
+    bool found = false;
+
+    // Stage 1: x = 3^(2p * all prime powers up to B1)
+    // Prime powers are batched into 32-bit exponents to cut down on the number of exponentiations.
+    mbedtls_mpi_lset(&x, 3);
+    uint32_t exponent = 2 * p;
+    for(uint32_t q = 2; q <= bounds.B1 && !flipper95_should_stop(instance);
+        q = prime_sieve_next(primes, q + 1)) {
+        uint32_t q_power = q;
+        while(q_power <= bounds.B1 / q) {
+            q_power *= q;
+        }
+        if(exponent > UINT32_MAX / q_power) {
+            p1_pow_mod(&ctx, &x, exponent, &base);
+            exponent = 1;
+        }
+        exponent *= q_power;
+    }
+    p1_pow_mod(&ctx, &x, exponent, &base);
+
+    mbedtls_mpi_sub_int(factor, &x, 1);
+    if(!flipper95_should_stop(instance)) {
+        found = p1_gcd_has_factor(&ctx, factor, factor);
+    }
+
+    // Stage 2: accumulate (x^q - 1) for all primes q in (B1, B2], walking the prime gaps with precomputed even powers of x
+    if(!found && bounds.B2 > bounds.B1 && !flipper95_should_stop(instance)) {
+        mbedtls_mpi x_q, acc;
+        mbedtls_mpi x_gaps[P1_STAGE2_GAP_TABLE_SIZE];
+        mbedtls_mpi_init(&x_q);
+        mbedtls_mpi_init(&acc);
+
+        mbedtls_mpi_init(&x_gaps[0]);
+        mbedtls_mpi_copy(&x_gaps[0], &x);
+        p1_mul_mod(&ctx, &x_gaps[0], &x);
+        for(size_t i = 1; i < P1_STAGE2_GAP_TABLE_SIZE; i++) {
+            mbedtls_mpi_init(&x_gaps[i]);
+            mbedtls_mpi_copy(&x_gaps[i], &x_gaps[i - 1]);
+            p1_mul_mod(&ctx, &x_gaps[i], &x_gaps[0]);
+        }
+
+        uint32_t q = prime_sieve_next(primes, bounds.B1 + 1);
+        mbedtls_mpi_copy(&x_q, &x);
+        p1_pow_mod(&ctx, &x_q, q, &base);
+        mbedtls_mpi_lset(&acc, 1);
+        while(q <= bounds.B2 && !flipper95_should_stop(instance)) {
+            mbedtls_mpi_sub_int(factor, &x_q, 1);
+            p1_mul_mod(&ctx, &acc, factor);
+
+            const uint32_t next_q = prime_sieve_next(primes, q + 1);
+            for(uint32_t gap = (next_q - q) / 2; gap > 0;) {
+                const uint32_t gap_step = MIN(gap, (uint32_t)P1_STAGE2_GAP_TABLE_SIZE);
+                p1_mul_mod(&ctx, &x_q, &x_gaps[gap_step - 1]);
+                gap -= gap_step;
+            }
+            q = next_q;
+        }
+
+        if(!flipper95_should_stop(instance)) {
+            found = p1_gcd_has_factor(&ctx, factor, &acc);
+        }
+
+        for(size_t i = 0; i < P1_STAGE2_GAP_TABLE_SIZE; i++) {
+            mbedtls_mpi_free(&x_gaps[i]);
+        }
+        mbedtls_mpi_free(&acc);
+        mbedtls_mpi_free(&x_q);
+    }
+
+    prime_sieve_free(primes);
+    mbedtls_mpi_free(&base);
+    mbedtls_mpi_free(&x);
+    return found;
+}
+
+static void flipper95_store_factor(Flipper95* instance, uint32_t p, const mbedtls_mpi* factor) {
+    size_t factor_str_len = 0;
+    mbedtls_mpi_write_string(factor, 10, NULL, 0, &factor_str_len);
+    char* factor_str = malloc(factor_str_len);
+    furi_check(
+        mbedtls_mpi_write_string(factor, 10, factor_str, factor_str_len, &factor_str_len) == 0);
+
+    furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
+    Stream* stream = file_stream_alloc(instance->storage);
+    if(file_stream_open(stream, FACTORS_PATH, FSAM_WRITE, FSOM_OPEN_APPEND)) {
+        stream_write_format(stream, "M%lu: %s\n", p, factor_str);
+    }
+    file_stream_close(stream);
+    stream_free(stream);
+    furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+
+    free(factor_str);
+}
+
+// Error checking of the LL residue with the Jacobi symbol, see lucas_lehmer_check_residue.
+// Error checks take at most 1/ERROR_CHECK_COST_RATIO of the runtime. If rolling back to the last good residue
+// fails ERROR_CHECK_MAX_RETRIES times in a row, the number is restarted from scratch.
+#define ERROR_CHECK_COST_RATIO  50
+#define ERROR_CHECK_MAX_RETRIES 3
+
+static bool flipper95_error_check_due(const Flipper95* instance) {
+    return furi_get_tick() - instance->last_error_check_tick >= instance->error_check_period;
+}
+
+// Returns false without counting an error if the app is stopping before the check completes
+static bool flipper95_check_residue(
+    Flipper95* instance,
+    uint32_t p,
+    uint32_t iteration,
+    const mbedtls_mpi* S,
+    const mbedtls_mpi* M_p,
+    MpiJacobi* jacobi) {
+    const uint32_t start_tick = furi_get_tick();
+
+    lucas_lehmer_start_check_residue(jacobi, S, M_p);
+    while(!mpi_jacobi_continue(jacobi, JACOBI_ROUNDS_PER_STEP)) {
+        if(flipper95_should_stop(instance)) {
+            return false;
+        }
+        flipper95_service_slice(instance, p, iteration);
+    }
+    const bool passed = jacobi->result == -1;
+
+    instance->last_error_check_tick = furi_get_tick();
+    const uint32_t check_ticks = instance->last_error_check_tick - start_tick;
+    instance->error_check_period = check_ticks * ERROR_CHECK_COST_RATIO;
+
+    furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
+    instance->error_check_ticks += check_ticks;
+    if(!passed) {
+        instance->hardware_errors++;
+    }
+    furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+    return passed;
+}
+
+static bool flipper95_telemetry_due(const Flipper95* instance) {
+    return furi_get_tick() - instance->telemetry_tick >=
+           furi_ms_to_ticks(TELEMETRY_SAMPLE_PERIOD_MS);
+}
+
+static void flipper95_sample_telemetry(Flipper95* instance, uint32_t p, uint32_t iteration) {
+    const uint32_t tick = furi_get_tick();
+    const float iterations_per_second = (float)instance->telemetry_iterations *
+                                        furi_kernel_get_tick_frequency() /
+                                        (tick - instance->telemetry_tick);
+
+    furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
+    instance->ll_mnumber = p;
+    instance->ll_iteration = iteration;
+    if(instance->iterations_per_second == 0.0f) {
+        instance->iterations_per_second = iterations_per_second;
+    } else {
+        instance->iterations_per_second +=
+            (iterations_per_second - instance->iterations_per_second) * TELEMETRY_SMOOTHING;
+    }
+    furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+
+    instance->telemetry_tick = tick;
+    instance->telemetry_iterations = 0;
+}
+
+// Must be called with the state mutex held
+static void flipper95_count_tested_exponent(Flipper95* instance) {
+    const uint32_t hour = flipper95_hours_since_start(instance);
+    if(hour - instance->history_hour >= TELEMETRY_HISTORY_HOURS) {
+        memset(instance->exponents_per_hour, 0, sizeof(instance->exponents_per_hour));
+    } else {
+        for(uint32_t i = instance->history_hour + 1; i <= hour; i++) {
+            instance->exponents_per_hour[i % TELEMETRY_HISTORY_HOURS] = 0;
+        }
+    }
+    instance->history_hour = hour;
+    instance->exponents_per_hour[hour % TELEMETRY_HISTORY_HOURS]++;
+    instance->exponents_tested++;
+}
+
 static void canvas_draw_ascii_str_wrapped_ellipsis(
     Canvas* canvas,
     const int32_t x,
@@ -249,11 +1223,20 @@ static void flipper95_run(Flipper95* instance) {
     canvas_reset(instance->canvas);
     canvas_set_font(instance->canvas, FontSecondary);
 
-    mbedtls_mpi M_p, S, temp;
+    mbedtls_mpi M_p, S, good_S, temp;
     mbedtls_mpi_init(&M_p);
     mbedtls_mpi_init(&S);
+    mbedtls_mpi_init(&good_S);
     mbedtls_mpi_init(&temp);
 
+    // Kept across numbers, so stepping to the next exponent is nearly free
+    PrimeSieve* exponent_sieve = prime_sieve_alloc();
+    LucasLehmerSlicedStep ll_step;
+    lucas_lehmer_sliced_step_init(&ll_step);
+    MpiJacobi jacobi;
+    mpi_jacobi_init(&jacobi);
+    P1BoundsCache p1_bounds_cache = {0};
+
     uint32_t hardware_status_y = 8;
     uint32_t prime_status_y = 16;
     uint32_t prime_display_y = 24;
@@ -268,66 +1251,146 @@ static void flipper95_run(Flipper95* instance) {
             p; // We'll use this later to check if the user has advanced the calculations themselves
 
         // Take the next prime p
-        while(!trial_division_is_prime(p)) {
-            ++p;
-        }
+        p = prime_sieve_next(exponent_sieve, p);
+
+        // Continue from the checkpoint if it saved a partial run of this exact number
+        uint32_t iteration = flipper95_take_resume_state(instance, p, &S);
 
         // Print the canvas BEFORE starting the iteration, so the current number is updated before
-        // we start heavy calculations.
-        char buffer[64];
-        snprintf(buffer, sizeof(buffer), ">M%lu", p);
-        canvas_draw_str_aligned(
-            instance->canvas, 128, prime_status_y, AlignRight, AlignTop, buffer);
+        // we start heavy calculations. The frame is kept until the test ends, so progress can be
+        // redrawn over it.
+        instance->mnumber_status_y = prime_status_y;
+        instance->mnumber_status_width = 0;
+        flipper95_draw_mnumber_status(instance, p, iteration);
+
+        mersenne_number(&M_p, p);
+
+        // Try to find a factor with P-1 first, if it's expected to pay off
+        const P1Bounds p1_bounds = p1_choose_bounds_cached(&p1_bounds_cache, p);
+        const bool has_factor = iteration == 0 && p1_bounds.B1 != 0 &&
+                                flipper95_p1_factor(
+                                    instance, p, p1_bounds, &M_p, &ll_step, &jacobi, &S, &temp);
+
+        // Last iteration whose residue passed the error check, to roll back to on hardware errors
+        uint32_t good_iteration = iteration;
+
+        // Perform the LL test, unless P-1 already proved M_p composite
+        if(!has_factor) {
+            if(iteration == 0) {
+                mbedtls_mpi_lset(&S, 4);
+            }
 
-        canvas_commit(instance->canvas);
-        canvas_clear(instance->canvas);
+            // And its residue
+            mbedtls_mpi_copy(&good_S, &S);
+            uint32_t failed_checks = 0;
+            lucas_lehmer_sliced_step_reset(&ll_step);
+            while(iteration < p - 2 && !flipper95_should_stop(instance)) {
+                // Huge exponents take several slices per iteration
+                const bool completed = lucas_lehmer_sliced_step(&ll_step, &S, &M_p, &temp);
+                if(completed) {
+                    iteration++;
+                    instance->telemetry_iterations++;
+                }
 
-        mbedtls_mpi_lset(&M_p, 1);
-        mbedtls_mpi_shift_l(&M_p, p); // 2^p
-        mbedtls_mpi_sub_int(&M_p, &M_p, 1); // 2^p - 1
+                // Between slices, respond to input and keep the progress on screen fresh
+                if(flipper95_slice_elapsed(instance)) {
+                    bool redraw = flipper95_end_slice(instance);
+                    if(flipper95_telemetry_due(instance)) {
+                        flipper95_sample_telemetry(instance, p, iteration);
+                        redraw = true;
+                    }
+                    if(redraw) {
+                        flipper95_draw_mnumber_status(instance, p, iteration);
+                    }
+                }
+                if(!completed) {
+                    continue;
+                }
 
-        // Perform the LL test
-        mbedtls_mpi_lset(&S, 4);
-        for(uint32_t i = 0;
-            i < p - 2 && atomic_load_explicit(&instance->stop, memory_order_relaxed) == 0;
-            i++) {
-            // S = (S^2 - 2) % M_p
-            mbedtls_mpi_mul_mpi(&temp, &S, &S); // temp = S^2
-            mbedtls_mpi_sub_int(&temp, &temp, 2); // temp = S^2 - 2
-            mbedtls_mpi_mod_mpi(&S, &temp, &M_p); // S = (S^2 - 2) % M_p
+                // With error checks on, checkpoints only ever store a checked residue,
+                // and the final residue is always checked
+                const bool checkpoint_due = flipper95_checkpoint_due(instance);
+                if(atomic_load_explicit(&instance->error_checks_enabled, memory_order_relaxed) &&
+                   (iteration == p - 2 || checkpoint_due || flipper95_error_check_due(instance))) {
+                    if(flipper95_check_residue(instance, p, iteration, &S, &M_p, &jacobi)) {
+                        mbedtls_mpi_copy(&good_S, &S);
+                        good_iteration = iteration;
+                        failed_checks = 0;
+                    } else if(flipper95_should_stop(instance)) {
+                        // Interrupted before the check completed, so S can't be trusted
+                        // to finish the test or to be checkpointed
+                        mbedtls_mpi_copy(&S, &good_S);
+                        iteration = good_iteration;
+                        break;
+                    } else {
+                        // The last good residue may have been corrupted in a way the check can't detect,
+                        // so start over if rolling back to it keeps failing
+                        if(++failed_checks >= ERROR_CHECK_MAX_RETRIES) {
+                            mbedtls_mpi_lset(&good_S, 4);
+                            good_iteration = 0;
+                            failed_checks = 0;
+                        }
+                        mbedtls_mpi_copy(&S, &good_S);
+                        iteration = good_iteration;
+                        continue;
+                    }
+                }
+
+                if(checkpoint_due) {
+                    flipper95_save_checkpoint(instance, p, iteration, &S);
+                }
+            }
         }
+        const bool finished = has_factor || iteration >= p - 2;
 
         bool is_prime = false;
         // Clear the skip flag, if present, and skip this number if it was set
-        if((atomic_fetch_and_explicit(&instance->stop, ~2, memory_order_relaxed) & 2) == 0) {
+        const bool skipped =
+            (atomic_fetch_and_explicit(&instance->stop, ~2, memory_order_relaxed) & 2) != 0;
+        if(!skipped && finished) {
+            if(has_factor) {
+                flipper95_store_factor(instance, p, &S);
+            }
+
             // Now update all the values we usually read from under the lock.
             // We can render the Mersenne prime without a lock, as this is the only place where it can update.
-            is_prime = mbedtls_mpi_cmp_int(&S, 0) == 0;
+            is_prime = !has_factor && lucas_lehmer_residue_is_prime(p, &S);
             furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
             if(instance->cur_mnumber == last_number) {
                 instance->cur_mnumber = p + 1;
             }
+            flipper95_count_tested_exponent(instance);
             if(is_prime) {
                 instance->cur_mprime = p;
+                flipper95_set_mprime_str(instance, p);
+            }
+            furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+        }
 
-                size_t required_buffer_len = 0;
-                mbedtls_mpi_write_string(
-                    &M_p, 10, instance->mprime_str, instance->mprime_str_len, &required_buffer_len);
-                if(required_buffer_len > instance->mprime_str_len) {
-                    free(instance->mprime_str);
-                    instance->mprime_str = malloc(required_buffer_len);
-                    instance->mprime_str_len = required_buffer_len;
-                }
-                furi_check(
-                    mbedtls_mpi_write_string(
-                        &M_p,
-                        10,
-                        instance->mprime_str,
-                        instance->mprime_str_len,
-                        &required_buffer_len) == 0);
+        if(!skipped && !finished) {
+            // Only exiting the app interrupts a run without skipping it, save the progress to resume it on the next start.
+            // The residue since the last check is unchecked, so fall back to the last checked one.
+            if(atomic_load_explicit(&instance->error_checks_enabled, memory_order_relaxed)) {
+                flipper95_save_checkpoint(instance, p, good_iteration, &good_S);
+            } else {
+                flipper95_save_checkpoint(instance, p, iteration, &S);
             }
+        } else if(flipper95_checkpoint_due(instance) || flipper95_should_stop(instance)) {
+            furi_check(furi_mutex_acquire(instance->state_mutex, FuriWaitForever) == FuriStatusOk);
+            const uint32_t next_number = instance->cur_mnumber;
             furi_check(furi_mutex_release(instance->state_mutex) == FuriStatusOk);
+            flipper95_save_checkpoint(instance, next_number, 0, NULL);
+        }
+
+        // Small exponents finish many times per second, so sample them between tests
+        if(flipper95_slice_elapsed(instance)) {
+            flipper95_end_slice(instance);
         }
+        if(flipper95_telemetry_due(instance)) {
+            flipper95_sample_telemetry(instance, p, iteration);
+        }
+
+        canvas_clear(instance->canvas);
 
         // Shift here as that's where we begin a new "frame" - if we shift displays up here,
         //  >Mxx will go up in the next iteration too
@@ -339,6 +1402,7 @@ static void flipper95_run(Flipper95* instance) {
         }
 
         // Just to be safe, opt for shorter display if we are operating on primes big enough
+        char buffer[64];
         const bool short_display = p >= 100000 || instance->cur_mprime >= 100000;
         snprintf(
             buffer,
@@ -399,7 +1463,11 @@ static void flipper95_run(Flipper95* instance) {
 
     mbedtls_mpi_free(&M_p);
     mbedtls_mpi_free(&S);
+    mbedtls_mpi_free(&good_S);
     mbedtls_mpi_free(&temp);
+    mpi_jacobi_free(&jacobi);
+    lucas_lehmer_sliced_step_free(&ll_step);
+    prime_sieve_free(exponent_sieve);
 
     furi_hal_power_insomnia_exit();
     cli_registry_delete_command(instance->cli, CLI_COMMAND);
@@ -0,0 +1,256 @@
+// Host front end of the flipper95 number crunching core. Tests a range of exponents on all cores
+// and checks the results against the known Mersenne primes.
+
+#include "util/lucas_lehmer.h"
+#include "util/prime_sieve.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_START 2
+#define DEFAULT_END   5000
+
+static const uint32_t known_mersenne_exponents[] = {
+    2,        3,        5,        7,        13,       17,       19,       31,       61,
+    89,       107,      127,      521,      607,      1279,     2203,     2281,     3217,
+    4253,     4423,     9689,     9941,     11213,    19937,    21701,    23209,    44497,
+    86243,    110503,   132049,   216091,   756839,   859433,   1257787,  1398269,  2976221,
+    3021377,  6972593,  13466917, 20996011, 24036583, 25964951, 30402457, 32582657, 37156667,
+    42643801, 43112609, 57885161, 74207281, 77232917, 82589933, 136279841,
+};
+
+typedef struct {
+    uint32_t p;
+    bool in_range; // Otherwise only queued to verify a known Mersenne prime
+    bool is_prime;
+} Exponent;
+
+typedef struct {
+    Exponent* exponents; // Largest first, so the longest tests never end up last
+    size_t count;
+    atomic_size_t next;
+} WorkQueue;
+
+typedef struct {
+    pthread_t thread;
+    WorkQueue* queue;
+    size_t exponents_tested;
+    uint64_t iterations;
+    double busy_seconds;
+} Worker;
+
+typedef struct {
+    double wall_seconds;
+    double busy_seconds;
+} RunTimes;
+
+static double now_seconds(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+static bool is_known_mersenne_exponent(uint32_t p) {
+    for(size_t i = 0; i < sizeof(known_mersenne_exponents) / sizeof(known_mersenne_exponents[0]);
+        i++) {
+        if(known_mersenne_exponents[i] == p) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int compare_exponents_descending(const void* a, const void* b) {
+    const uint32_t p_a = ((const Exponent*)a)->p;
+    const uint32_t p_b = ((const Exponent*)b)->p;
+    return (p_a < p_b) - (p_a > p_b);
+}
+
+static void* worker_thread(void* context) {
+    Worker* worker = context;
+    WorkQueue* queue = worker->queue;
+    for(;;) {
+        const size_t index = atomic_fetch_add_explicit(&queue->next, 1, memory_order_relaxed);
+        if(index >= queue->count) {
+            break;
+        }
+
+        Exponent* exponent = &queue->exponents[index];
+        const double start = now_seconds();
+        exponent->is_prime = lucas_lehmer_test(exponent->p);
+        worker->busy_seconds += now_seconds() - start;
+        worker->exponents_tested++;
+        worker->iterations += exponent->p - 2;
+    }
+    return NULL;
+}
+
+static RunTimes run_queue(WorkQueue* queue, uint32_t num_threads, bool print_workers) {
+    Worker* workers = calloc(num_threads, sizeof(Worker));
+    atomic_store(&queue->next, 0);
+
+    const double start = now_seconds();
+    for(uint32_t i = 0; i < num_threads; i++) {
+        workers[i].queue = queue;
+        if(pthread_create(&workers[i].thread, NULL, worker_thread, &workers[i]) != 0) {
+            fprintf(stderr, "Failed to start thread %u\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    RunTimes times = {0};
+    for(uint32_t i = 0; i < num_threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    times.wall_seconds = now_seconds() - start;
+
+    for(uint32_t i = 0; i < num_threads; i++) {
+        const Worker* worker = &workers[i];
+        times.busy_seconds += worker->busy_seconds;
+        if(print_workers) {
+            printf(
+                "Thread %u: %zu exponents, %llu iterations in %.2fs, %.0f iterations/s\n",
+                i,
+                worker->exponents_tested,
+                (unsigned long long)worker->iterations,
+                worker->busy_seconds,
+                worker->busy_seconds > 0.0 ? worker->iterations / worker->busy_seconds : 0.0);
+        }
+    }
+    free(workers);
+    return times;
+}
+
+static void print_usage(const char* name) {
+    printf(
+        "Usage: %s [-s start] [-e end] [-v verify_limit] [-t threads] [-b]\n"
+        "\t-s, -e\tRange of exponents to test, %u to %u by default\n"
+        "\t-v\tAlso verify all known Mersenne primes up to this exponent, end by default\n"
+        "\t-t\tNumber of threads, all cores by default\n"
+        "\t-b\tRun on a single thread first, to measure the real scaling efficiency\n",
+        name,
+        DEFAULT_START,
+        DEFAULT_END);
+}
+
+int main(int argc, char** argv) {
+    uint32_t start = DEFAULT_START;
+    uint32_t end = DEFAULT_END;
+    uint32_t verify_limit = 0;
+    bool verify_limit_set = false;
+    long num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    bool baseline = false;
+
+    int option;
+    while((option = getopt(argc, argv, "s:e:v:t:bh")) != -1) {
+        switch(option) {
+        case 's':
+            start = strtoul(optarg, NULL, 10);
+            break;
+        case 'e':
+            end = strtoul(optarg, NULL, 10);
+            break;
+        case 'v':
+            verify_limit = strtoul(optarg, NULL, 10);
+            verify_limit_set = true;
+            break;
+        case 't':
+            num_threads = strtol(optarg, NULL, 10);
+            break;
+        case 'b':
+            baseline = true;
+            break;
+        default:
+            print_usage(argv[0]);
+            return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if(!verify_limit_set) {
+        verify_limit = end;
+    }
+    if(start < 2 || end < start || num_threads < 1) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Prime exponents in the range, then the known Mersenne primes past it
+    WorkQueue queue = {0};
+    size_t capacity = 64;
+    queue.exponents = malloc(capacity * sizeof(Exponent));
+    PrimeSieve* sieve = prime_sieve_alloc();
+    for(uint32_t p = prime_sieve_next(sieve, start); p <= end && p >= start;
+        p = prime_sieve_next(sieve, p + 1)) {
+        if(queue.count == capacity) {
+            capacity *= 2;
+            queue.exponents = realloc(queue.exponents, capacity * sizeof(Exponent));
+        }
+        queue.exponents[queue.count++] = (Exponent){.p = p, .in_range = true};
+    }
+    prime_sieve_free(sieve);
+    for(size_t i = 0; i < sizeof(known_mersenne_exponents) / sizeof(known_mersenne_exponents[0]);
+        i++) {
+        const uint32_t p = known_mersenne_exponents[i];
+        if(p <= verify_limit && (p < start || p > end)) {
+            if(queue.count == capacity) {
+                capacity *= 2;
+                queue.exponents = realloc(queue.exponents, capacity * sizeof(Exponent));
+            }
+            queue.exponents[queue.count++] = (Exponent){.p = p, .in_range = false};
+        }
+    }
+    qsort(queue.exponents, queue.count, sizeof(Exponent), compare_exponents_descending);
+
+    printf(
+        "Testing %zu exponents from M%u to M%u on %ld threads\n",
+        queue.count,
+        queue.count != 0 ? queue.exponents[queue.count - 1].p : 0,
+        queue.count != 0 ? queue.exponents[0].p : 0,
+        num_threads);
+
+    double baseline_seconds = 0.0;
+    if(baseline) {
+        baseline_seconds = run_queue(&queue, 1, false).wall_seconds;
+        printf("Single thread baseline: %.2fs\n", baseline_seconds);
+    }
+    const RunTimes times = run_queue(&queue, num_threads, true);
+
+    // Results come out largest first, list them in ascending order
+    size_t mismatches = 0;
+    size_t verified = 0;
+    for(size_t i = queue.count; i-- > 0;) {
+        const Exponent* exponent = &queue.exponents[i];
+        const bool known = is_known_mersenne_exponent(exponent->p);
+        if(exponent->in_range && exponent->is_prime) {
+            printf("M%u is prime\n", exponent->p);
+        }
+        if(known || exponent->p <= verify_limit) {
+            verified++;
+            if(exponent->is_prime != known) {
+                printf(
+                    "MISMATCH: M%u should be %s\n", exponent->p, known ? "prime" : "composite");
+                mismatches++;
+            }
+        }
+    }
+    printf("Verified %zu exponents, %zu mismatches\n", verified, mismatches);
+
+    printf(
+        "Wall time %.2fs, threads busy %.1f%% of the time\n",
+        times.wall_seconds,
+        times.busy_seconds * 100.0 / (times.wall_seconds * num_threads));
+    if(baseline) {
+        const double speedup = baseline_seconds / times.wall_seconds;
+        printf(
+            "Speedup %.2fx on %ld threads, %.1f%% scaling efficiency\n",
+            speedup,
+            num_threads,
+            speedup * 100.0 / num_threads);
+    }
+
+    free(queue.exponents);
+    return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
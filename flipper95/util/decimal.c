@@ -0,0 +1,262 @@
+#include "decimal.h"
+
+#include <mbedtls/bignum.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Extra mantissa digits carried when computing leading digits, so truncation errors
+// accumulated over the log2(p) steps never reach the digits that are output
+#define LEADING_DIGITS_GUARD 20
+
+#define ELLIPSIS     "..."
+#define ELLIPSIS_LEN (sizeof(ELLIPSIS) - 1)
+
+// Writes X in decimal to buf, left padded with zeros to num_digits characters.
+// mbedtls wants a buffer sized for a conservative estimate, so go through a scratch one
+static size_t mpi_write_decimal(const mbedtls_mpi* X, char* buf, size_t num_digits) {
+    size_t scratch_len = 0;
+    mbedtls_mpi_write_string(X, 10, NULL, 0, &scratch_len);
+    char* scratch = malloc(scratch_len);
+    mbedtls_mpi_write_string(X, 10, scratch, scratch_len, &scratch_len);
+
+    const size_t len = strlen(scratch);
+    const size_t padding = len < num_digits ? num_digits - len : 0;
+    memset(buf, '0', padding);
+    memcpy(buf + padding, scratch, len + 1);
+    free(scratch);
+    return padding + len;
+}
+
+uint32_t mersenne_leading_digits(uint32_t p, char* buf, size_t num_digits) {
+    const size_t mantissa_digits = num_digits + LEADING_DIGITS_GUARD;
+
+    mbedtls_mpi mantissa, limit, temp;
+    mbedtls_mpi_init(&mantissa);
+    mbedtls_mpi_init(&limit);
+    mbedtls_mpi_init(&temp);
+
+    mbedtls_mpi_lset(&limit, 1);
+    for(size_t i = 0; i < mantissa_digits; i++) {
+        mbedtls_mpi_mul_int(&limit, &limit, 10);
+    }
+
+    // 2^p = mantissa x 10^exponent, with the mantissa truncated to mantissa_digits digits.
+    // Binary exponentiation squares the mantissa and doubles the exponent, so a handful of
+    // small multiplications replace the full conversion of 2^p
+    uint32_t exponent = 0;
+    mbedtls_mpi_lset(&mantissa, 1);
+    for(int32_t bit = 31 - __builtin_clz(p); bit >= 0; bit--) {
+        mbedtls_mpi_mul_mpi(&temp, &mantissa, &mantissa);
+        mbedtls_mpi_swap(&mantissa, &temp);
+        exponent *= 2;
+        if(p & (1u << bit)) {
+            mbedtls_mpi_shift_l(&mantissa, 1);
+        }
+        while(mbedtls_mpi_cmp_mpi(&mantissa, &limit) >= 0) {
+            mbedtls_mpi_div_int(&mantissa, NULL, &mantissa, 10);
+            exponent++;
+        }
+    }
+
+    // While nothing got truncated, the mantissa holds 2^p exactly. Otherwise 2^p ends with
+    // a nonzero digit, so subtracting 1 can't borrow into the leading digits
+    if(exponent == 0) {
+        mbedtls_mpi_sub_int(&mantissa, &mantissa, 1);
+    }
+
+    // Write the whole mantissa, then cut it down to the requested digits
+    size_t scratch_len = 0;
+    mbedtls_mpi_write_string(&mantissa, 10, NULL, 0, &scratch_len);
+    char* scratch = malloc(scratch_len);
+    mbedtls_mpi_write_string(&mantissa, 10, scratch, scratch_len, &scratch_len);
+
+    const size_t mantissa_len = strlen(scratch);
+    const size_t len = mantissa_len < num_digits ? mantissa_len : num_digits;
+    memcpy(buf, scratch, len);
+    buf[len] = '\0';
+    free(scratch);
+
+    mbedtls_mpi_free(&temp);
+    mbedtls_mpi_free(&limit);
+    mbedtls_mpi_free(&mantissa);
+
+    return mantissa_len + exponent;
+}
+
+void mersenne_trailing_digits(uint32_t p, char* buf, size_t num_digits) {
+    mbedtls_mpi modulus, result, temp;
+    mbedtls_mpi_init(&modulus);
+    mbedtls_mpi_init(&result);
+    mbedtls_mpi_init(&temp);
+
+    mbedtls_mpi_lset(&modulus, 1);
+    for(size_t i = 0; i < num_digits; i++) {
+        mbedtls_mpi_mul_int(&modulus, &modulus, 10);
+    }
+
+    // 2^p mod 10^k - mbedtls_mpi_exp_mod only accepts odd moduli, so square and multiply by hand
+    mbedtls_mpi_lset(&result, 1);
+    for(int32_t bit = 31 - __builtin_clz(p); bit >= 0; bit--) {
+        mbedtls_mpi_mul_mpi(&temp, &result, &result);
+        mbedtls_mpi_mod_mpi(&result, &temp, &modulus);
+        if(p & (1u << bit)) {
+            mbedtls_mpi_shift_l(&result, 1);
+            mbedtls_mpi_mod_mpi(&result, &result, &modulus);
+        }
+    }
+
+    // 2^p is never divisible by 10, so this can't go negative
+    mbedtls_mpi_sub_int(&result, &result, 1);
+    mpi_write_decimal(&result, buf, num_digits);
+
+    mbedtls_mpi_free(&temp);
+    mbedtls_mpi_free(&result);
+    mbedtls_mpi_free(&modulus);
+}
+
+uint32_t mersenne_to_decimal_abbreviated(uint32_t p, char* buf, size_t buf_size) {
+    const size_t max_len = buf_size - 1;
+    const size_t edge_digits = (max_len - ELLIPSIS_LEN) / 2;
+
+    const uint32_t num_digits = mersenne_leading_digits(p, buf, edge_digits);
+    if(num_digits <= max_len) {
+        // Small enough to convert in full
+        mbedtls_mpi M_p;
+        mbedtls_mpi_init(&M_p);
+        mbedtls_mpi_lset(&M_p, 1);
+        mbedtls_mpi_shift_l(&M_p, p); // 2^p
+        mbedtls_mpi_sub_int(&M_p, &M_p, 1); // 2^p - 1
+        mpi_write_decimal(&M_p, buf, 0);
+        mbedtls_mpi_free(&M_p);
+    } else {
+        memcpy(buf + edge_digits, ELLIPSIS, ELLIPSIS_LEN);
+        mersenne_trailing_digits(p, buf + edge_digits + ELLIPSIS_LEN, edge_digits);
+    }
+    return num_digits;
+}
+
+// Numbers below 10^DECIMAL_LEAF_DIGITS are converted directly by mbedtls
+#define DECIMAL_LEAF_DIGITS 128
+#define DECIMAL_CHUNK_SIZE  64
+#define DECIMAL_MAX_LEVELS  32
+
+typedef struct {
+    DecimalOutputCallback callback;
+    void* context;
+    bool cancelled;
+
+    mbedtls_mpi powers[DECIMAL_MAX_LEVELS]; // powers[i] = 10^(DECIMAL_LEAF_DIGITS x 2^i)
+    char* scratch;
+    size_t scratch_len;
+
+    size_t chunk_len;
+    char chunk[DECIMAL_CHUNK_SIZE];
+} DecimalWriter;
+
+static void decimal_writer_flush(DecimalWriter* writer) {
+    if(writer->chunk_len != 0 && !writer->cancelled) {
+        writer->cancelled = !writer->callback(writer->chunk, writer->chunk_len, writer->context);
+    }
+    writer->chunk_len = 0;
+}
+
+static void decimal_writer_put(DecimalWriter* writer, char c) {
+    writer->chunk[writer->chunk_len++] = c;
+    if(writer->chunk_len == DECIMAL_CHUNK_SIZE) {
+        decimal_writer_flush(writer);
+    }
+}
+
+// Writes X < powers[level + 1], zero padded to its full width if pad is set
+static void decimal_writer_write(
+    DecimalWriter* writer,
+    const mbedtls_mpi* X,
+    int32_t level,
+    bool pad) {
+    if(writer->cancelled) {
+        return;
+    }
+
+    if(level < 0) {
+        size_t len = 0;
+        mbedtls_mpi_write_string(X, 10, writer->scratch, writer->scratch_len, &len);
+        len = strlen(writer->scratch);
+        for(size_t i = len; pad && i < DECIMAL_LEAF_DIGITS; i++) {
+            decimal_writer_put(writer, '0');
+        }
+        for(size_t i = 0; i < len; i++) {
+            decimal_writer_put(writer, writer->scratch[i]);
+        }
+        return;
+    }
+
+    // Leading digits don't get padded, so there's nothing to split off if the high half is zero
+    if(!pad && mbedtls_mpi_cmp_mpi(X, &writer->powers[level]) < 0) {
+        decimal_writer_write(writer, X, level - 1, false);
+        return;
+    }
+
+    // Split into the high and low halves, and output them depth first so only one path
+    // of the recursion is held in memory at a time
+    mbedtls_mpi Q, R;
+    mbedtls_mpi_init(&Q);
+    mbedtls_mpi_init(&R);
+    mbedtls_mpi_div_mpi(&Q, &R, X, &writer->powers[level]);
+
+    decimal_writer_write(writer, &Q, level - 1, pad);
+    mbedtls_mpi_free(&Q);
+    decimal_writer_write(writer, &R, level - 1, true);
+    mbedtls_mpi_free(&R);
+}
+
+bool mpi_write_decimal_streamed(
+    const mbedtls_mpi* X,
+    DecimalOutputCallback callback,
+    void* context) {
+    // Too big for the stack of a CLI command
+    DecimalWriter* writer = malloc(sizeof(DecimalWriter));
+    writer->callback = callback;
+    writer->context = context;
+    writer->cancelled = false;
+    writer->chunk_len = 0;
+
+    for(size_t i = 0; i < DECIMAL_MAX_LEVELS; i++) {
+        mbedtls_mpi_init(&writer->powers[i]);
+    }
+    mbedtls_mpi_lset(&writer->powers[0], 1);
+    for(size_t i = 0; i < DECIMAL_LEAF_DIGITS; i++) {
+        mbedtls_mpi_mul_int(&writer->powers[0], &writer->powers[0], 10);
+    }
+
+    // Cache the powers up to the largest one not exceeding X, which is where the top level splits
+    int32_t top_level = -1;
+    while(top_level + 1 < DECIMAL_MAX_LEVELS &&
+          mbedtls_mpi_cmp_mpi(&writer->powers[top_level + 1], X) <= 0) {
+        top_level++;
+        if(top_level + 1 < DECIMAL_MAX_LEVELS &&
+           2 * mbedtls_mpi_bitlen(&writer->powers[top_level]) - 2 <= mbedtls_mpi_bitlen(X)) {
+            mbedtls_mpi_mul_mpi(
+                &writer->powers[top_level + 1],
+                &writer->powers[top_level],
+                &writer->powers[top_level]);
+        } else {
+            break;
+        }
+    }
+
+    // Leaves are below powers[0], so size the scratch buffer for it
+    mbedtls_mpi_write_string(&writer->powers[0], 10, NULL, 0, &writer->scratch_len);
+    writer->scratch = malloc(writer->scratch_len);
+
+    decimal_writer_write(writer, X, top_level, false);
+    decimal_writer_flush(writer);
+
+    const bool completed = !writer->cancelled;
+    free(writer->scratch);
+    for(size_t i = 0; i < DECIMAL_MAX_LEVELS; i++) {
+        mbedtls_mpi_free(&writer->powers[i]);
+    }
+    free(writer);
+    return completed;
+}
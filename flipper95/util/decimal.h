@@ -0,0 +1,40 @@
+#pragma once
+
+#include <mbedtls/bignum.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Writes num_digits leading decimal digits of 2^p - 1 (or all of them, if it has fewer)
+// to buf, which must hold num_digits + 1 characters. Returns the total number of decimal
+// digits of 2^p - 1. Only the leading digits are ever computed, so this is cheap even for huge p
+uint32_t mersenne_leading_digits(uint32_t p, char* buf, size_t num_digits);
+
+// Writes the last num_digits decimal digits of 2^p - 1, zero padded, to buf,
+// which must hold num_digits + 1 characters
+void mersenne_trailing_digits(uint32_t p, char* buf, size_t num_digits);
+
+// Writes 2^p - 1 in decimal to buf. If it doesn't fit, it's abbreviated to
+// "<leading digits>...<trailing digits>" without ever converting the whole number.
+// Returns the total number of decimal digits of 2^p - 1
+uint32_t mersenne_to_decimal_abbreviated(uint32_t p, char* buf, size_t buf_size);
+
+// Receives the next chunk of digits, not NUL terminated. Return false to cancel the conversion
+typedef bool (*DecimalOutputCallback)(const char* digits, size_t len, void* context);
+
+// Converts a non-negative X to decimal with divide and conquer, handing the digits to callback in small chunks
+// as they become available. Memory use is bounded by a few times the size of X, the decimal
+// string is never stored in full. Returns false if the callback cancelled the conversion
+bool mpi_write_decimal_streamed(
+    const mbedtls_mpi* X,
+    DecimalOutputCallback callback,
+    void* context);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,220 @@
+#include "lucas_lehmer.h"
+
+#include <stdlib.h>
+
+// Bytes of S multiplied in per slice of an LL iteration, or of B in mersenne_sliced_mul_mod.
+// Multiplications modulo M_p below LUCAS_LEHMER_SLICE_MIN_BYTES are short enough to run in one go.
+#define LUCAS_LEHMER_SLICE_BYTES     512
+#define LUCAS_LEHMER_SLICE_MIN_BYTES 2048
+
+void mersenne_number(mbedtls_mpi* M_p, uint32_t p) {
+    mbedtls_mpi_lset(M_p, 1);
+    mbedtls_mpi_shift_l(M_p, p); // 2^p
+    mbedtls_mpi_sub_int(M_p, M_p, 1); // 2^p - 1
+}
+
+// 2^p = 1 (mod M_p), so the bits past p fold back onto the low bits with an addition.
+// That's linear, while mbedtls_mpi_mod_mpi is a long division as costly as the squaring itself.
+void mersenne_reduce(mbedtls_mpi* X, const mbedtls_mpi* M_p, mbedtls_mpi* temp) {
+    const size_t p = mbedtls_mpi_bitlen(M_p);
+    while(mbedtls_mpi_bitlen(X) > p) {
+        mbedtls_mpi_copy(temp, X);
+        mbedtls_mpi_shift_r(temp, p); // temp = X >> p
+        mbedtls_mpi_shift_l(temp, p);
+        mbedtls_mpi_sub_mpi(X, X, temp); // X = X & M_p
+        mbedtls_mpi_shift_r(temp, p);
+        mbedtls_mpi_add_mpi(X, X, temp); // X = (X & M_p) + (X >> p)
+    }
+    if(mbedtls_mpi_cmp_mpi(X, M_p) >= 0) {
+        mbedtls_mpi_sub_mpi(X, X, M_p);
+    }
+}
+
+// S = S - 2 (mod M_p), for 0 <= S < M_p
+static void lucas_lehmer_sub_2(mbedtls_mpi* S, const mbedtls_mpi* M_p) {
+    mbedtls_mpi_sub_int(S, S, 2);
+    if(mbedtls_mpi_cmp_int(S, 0) < 0) {
+        mbedtls_mpi_add_mpi(S, S, M_p);
+    }
+}
+
+void lucas_lehmer_step(mbedtls_mpi* S, const mbedtls_mpi* M_p, mbedtls_mpi* temp) {
+    mbedtls_mpi_mul_mpi(temp, S, S); // temp = S^2
+    mersenne_reduce(temp, M_p, S); // temp = S^2 % M_p
+    mbedtls_mpi_swap(S, temp);
+    lucas_lehmer_sub_2(S, M_p); // S = (S^2 - 2) % M_p
+}
+
+void lucas_lehmer_sliced_step_init(LucasLehmerSlicedStep* step) {
+    mbedtls_mpi_init(&step->product);
+    mbedtls_mpi_init(&step->chunk);
+    step->digits = NULL;
+    step->digits_capacity = 0;
+    step->offset = 0;
+}
+
+void lucas_lehmer_sliced_step_free(LucasLehmerSlicedStep* step) {
+    free(step->digits);
+    mbedtls_mpi_free(&step->chunk);
+    mbedtls_mpi_free(&step->product);
+}
+
+void lucas_lehmer_sliced_step_reset(LucasLehmerSlicedStep* step) {
+    step->offset = 0;
+}
+
+bool lucas_lehmer_sliced_step(
+    LucasLehmerSlicedStep* step,
+    mbedtls_mpi* S,
+    const mbedtls_mpi* M_p,
+    mbedtls_mpi* temp) {
+    if(!mersenne_sliced_mul_mod(step, S, S, M_p, temp)) {
+        return false;
+    }
+    lucas_lehmer_sub_2(S, M_p);
+    return true;
+}
+
+// X x B = sum of X x chunk_i << (i x chunk bits), so the product splits into multiplications
+// by a few limbs each. All slices together cost the same as one schoolbook multiplication.
+bool mersenne_sliced_mul_mod(
+    LucasLehmerSlicedStep* step,
+    mbedtls_mpi* X,
+    const mbedtls_mpi* B,
+    const mbedtls_mpi* M_p,
+    mbedtls_mpi* temp) {
+    const size_t size = mbedtls_mpi_size(M_p);
+    if(size < LUCAS_LEHMER_SLICE_MIN_BYTES) {
+        mbedtls_mpi_mul_mpi(temp, X, B);
+        mersenne_reduce(temp, M_p, &step->product);
+        mbedtls_mpi_swap(X, temp);
+        return true;
+    }
+
+    if(step->offset == 0) {
+        if(step->digits_capacity < size) {
+            free(step->digits);
+            step->digits = malloc(size);
+            step->digits_capacity = size;
+        }
+        mbedtls_mpi_write_binary_le(B, step->digits, size);
+        mbedtls_mpi_lset(&step->product, 0);
+    }
+
+    const size_t len = size - step->offset < LUCAS_LEHMER_SLICE_BYTES ? size - step->offset :
+                                                                        LUCAS_LEHMER_SLICE_BYTES;
+    mbedtls_mpi_read_binary_le(&step->chunk, step->digits + step->offset, len);
+    mbedtls_mpi_mul_mpi(temp, X, &step->chunk);
+    mbedtls_mpi_shift_l(temp, step->offset * 8);
+    mbedtls_mpi_add_mpi(&step->product, &step->product, temp);
+    step->offset += len;
+    if(step->offset < size) {
+        return false;
+    }
+
+    step->offset = 0;
+    mersenne_reduce(&step->product, M_p, temp);
+    mbedtls_mpi_swap(X, &step->product);
+    return true;
+}
+
+bool lucas_lehmer_residue_is_prime(uint32_t p, const mbedtls_mpi* S) {
+    // The test only holds for odd p, M2 = 3 runs no iterations and is prime
+    return p == 2 || mbedtls_mpi_cmp_int(S, 0) == 0;
+}
+
+bool lucas_lehmer_test(uint32_t p) {
+    mbedtls_mpi M_p, S, temp;
+    mbedtls_mpi_init(&M_p);
+    mbedtls_mpi_init(&S);
+    mbedtls_mpi_init(&temp);
+
+    mersenne_number(&M_p, p);
+    mbedtls_mpi_lset(&S, 4);
+    for(uint32_t i = 2; i < p; i++) {
+        lucas_lehmer_step(&S, &M_p, &temp);
+    }
+    const bool is_prime = lucas_lehmer_residue_is_prime(p, &S);
+
+    mbedtls_mpi_free(&temp);
+    mbedtls_mpi_free(&S);
+    mbedtls_mpi_free(&M_p);
+    return is_prime;
+}
+
+int mpi_jacobi(const mbedtls_mpi* A, const mbedtls_mpi* N) {
+    MpiJacobi jacobi;
+    mpi_jacobi_init(&jacobi);
+    mpi_jacobi_start(&jacobi, A, N);
+    mpi_jacobi_continue(&jacobi, UINT32_MAX);
+    const int result = jacobi.result;
+    mpi_jacobi_free(&jacobi);
+    return result;
+}
+
+void mpi_jacobi_init(MpiJacobi* jacobi) {
+    mbedtls_mpi_init(&jacobi->a);
+    mbedtls_mpi_init(&jacobi->n);
+    jacobi->result = 1;
+}
+
+void mpi_jacobi_free(MpiJacobi* jacobi) {
+    mbedtls_mpi_free(&jacobi->n);
+    mbedtls_mpi_free(&jacobi->a);
+}
+
+void mpi_jacobi_start(MpiJacobi* jacobi, const mbedtls_mpi* A, const mbedtls_mpi* N) {
+    mbedtls_mpi_mod_mpi(&jacobi->a, A, N);
+    mbedtls_mpi_copy(&jacobi->n, N);
+    jacobi->result = 1;
+}
+
+// The binary variant, like the binary GCD: every round only shifts and subtracts,
+// where a division of the Euclidean variant would allocate and could take much longer
+bool mpi_jacobi_continue(MpiJacobi* jacobi, uint32_t max_rounds) {
+    mbedtls_mpi* a = &jacobi->a;
+    mbedtls_mpi* n = &jacobi->n;
+    for(uint32_t round = 0; round < max_rounds; round++) {
+        if(mbedtls_mpi_cmp_int(a, 0) == 0) {
+            if(mbedtls_mpi_cmp_int(n, 1) != 0) {
+                jacobi->result = 0;
+            }
+            return true;
+        }
+
+        const size_t twos = mbedtls_mpi_lsb(a);
+        mbedtls_mpi_shift_r(a, twos);
+        // (2/n) = -1 if n = 3, 5 (mod 8)
+        if((twos & 1) != 0 && (mbedtls_mpi_get_bit(n, 1) ^ mbedtls_mpi_get_bit(n, 2)) != 0) {
+            jacobi->result = -jacobi->result;
+        }
+        // Both are odd now. Quadratic reciprocity flips the sign if both a and n are 3 (mod 4)
+        if(mbedtls_mpi_cmp_mpi(a, n) < 0) {
+            mbedtls_mpi_swap(a, n);
+            if(mbedtls_mpi_get_bit(a, 1) != 0 && mbedtls_mpi_get_bit(n, 1) != 0) {
+                jacobi->result = -jacobi->result;
+            }
+        }
+        // (a/n) = ((a - n)/n), and a - n is even for the next round
+        mbedtls_mpi_sub_abs(a, a, n);
+    }
+    return false;
+}
+
+// For every LL iteration past the first, (S - 2 / M_p) = -1,
+// while a residue corrupted by a hardware fault fails this check half of the time
+bool lucas_lehmer_check_residue(const mbedtls_mpi* S, const mbedtls_mpi* M_p, mbedtls_mpi* temp) {
+    mbedtls_mpi_sub_int(temp, S, 2);
+    if(mbedtls_mpi_cmp_int(temp, 0) < 0) {
+        mbedtls_mpi_add_mpi(temp, temp, M_p);
+    }
+    return mpi_jacobi(temp, M_p) == -1;
+}
+
+void lucas_lehmer_start_check_residue(
+    MpiJacobi* jacobi,
+    const mbedtls_mpi* S,
+    const mbedtls_mpi* M_p) {
+    mpi_jacobi_start(jacobi, S, M_p);
+    lucas_lehmer_sub_2(&jacobi->a, M_p);
+}
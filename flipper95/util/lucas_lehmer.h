@@ -0,0 +1,98 @@
+#pragma once
+
+#include <mbedtls/bignum.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The number crunching core of flipper95. It only depends on mbedtls, so it builds for the host too
+
+// M_p = 2^p - 1
+void mersenne_number(mbedtls_mpi* M_p, uint32_t p);
+
+// X = X % M_p for a non-negative X, without a division
+void mersenne_reduce(mbedtls_mpi* X, const mbedtls_mpi* M_p, mbedtls_mpi* temp);
+
+// One iteration of the LL test, S = (S^2 - 2) % M_p
+void lucas_lehmer_step(mbedtls_mpi* S, const mbedtls_mpi* M_p, mbedtls_mpi* temp);
+
+// One iteration of the LL test split into slices of a bounded duration, so huge exponents
+// can be interrupted mid-iteration. S must stay untouched until the iteration completes.
+// Also splits up any other multiplication modulo M_p, see mersenne_sliced_mul_mod.
+typedef struct {
+    mbedtls_mpi product; // X x B accumulated so far
+    mbedtls_mpi chunk;
+    uint8_t* digits; // B in little endian, multiplied in one chunk at a time
+    size_t digits_capacity;
+    size_t offset; // Bytes of B multiplied in so far, 0 between multiplications
+} LucasLehmerSlicedStep;
+
+void lucas_lehmer_sliced_step_init(LucasLehmerSlicedStep* step);
+
+void lucas_lehmer_sliced_step_free(LucasLehmerSlicedStep* step);
+
+// Drops the partially computed iteration, needed whenever S is changed from outside
+void lucas_lehmer_sliced_step_reset(LucasLehmerSlicedStep* step);
+
+// Performs one slice of the current iteration.
+// Returns true once the iteration completes and S is updated
+bool lucas_lehmer_sliced_step(
+    LucasLehmerSlicedStep* step,
+    mbedtls_mpi* S,
+    const mbedtls_mpi* M_p,
+    mbedtls_mpi* temp);
+
+// Performs one slice of X = X * B % M_p, for 0 <= X, B < M_p. B may be X itself.
+// Returns true once the multiplication completes and X is updated.
+// X and B must stay untouched until then
+bool mersenne_sliced_mul_mod(
+    LucasLehmerSlicedStep* step,
+    mbedtls_mpi* X,
+    const mbedtls_mpi* B,
+    const mbedtls_mpi* M_p,
+    mbedtls_mpi* temp);
+
+// Whether the residue left after all p - 2 iterations proves M_p prime
+bool lucas_lehmer_residue_is_prime(uint32_t p, const mbedtls_mpi* S);
+
+// Runs the whole LL test of M_p in one go
+bool lucas_lehmer_test(uint32_t p);
+
+// Jacobi symbol (A/N) for an odd, positive N
+int mpi_jacobi(const mbedtls_mpi* A, const mbedtls_mpi* N);
+
+// The Jacobi symbol computed a bounded number of rounds at a time, each linear in the size of N.
+// Once done, n is gcd(A, N), so this also serves as a GCD that can be interrupted.
+typedef struct {
+    mbedtls_mpi a;
+    mbedtls_mpi n;
+    int result; // The symbol, once done
+} MpiJacobi;
+
+void mpi_jacobi_init(MpiJacobi* jacobi);
+
+void mpi_jacobi_free(MpiJacobi* jacobi);
+
+// Starts over with (A/N) for an odd, positive N
+void mpi_jacobi_start(MpiJacobi* jacobi, const mbedtls_mpi* A, const mbedtls_mpi* N);
+
+// Runs up to max_rounds rounds. Returns true once the symbol is known
+bool mpi_jacobi_continue(MpiJacobi* jacobi, uint32_t max_rounds);
+
+// Error check of the LL residue after at least one iteration, see the implementation for details
+bool lucas_lehmer_check_residue(const mbedtls_mpi* S, const mbedtls_mpi* M_p, mbedtls_mpi* temp);
+
+// Starts the same check on jacobi, the residue passes if the symbol comes out as -1
+void lucas_lehmer_start_check_residue(
+    MpiJacobi* jacobi,
+    const mbedtls_mpi* S,
+    const mbedtls_mpi* M_p);
+
+#ifdef __cplusplus
+}
+#endif
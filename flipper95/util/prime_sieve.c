@@ -0,0 +1,124 @@
+#include "prime_sieve.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Numbers covered by one window. Only odd numbers are stored, one bit each
+#define PRIME_SIEVE_WINDOW 16384
+
+struct PrimeSieve {
+    uint32_t window_start; // Odd
+    uint64_t window_end; // Exclusive
+
+    // Odd primes up to base_limit, enough to sieve windows up to base_limit^2
+    uint16_t* base_primes;
+    size_t num_base_primes;
+    size_t base_primes_capacity;
+    uint32_t base_limit;
+
+    uint8_t composite[PRIME_SIEVE_WINDOW / 16];
+};
+
+PrimeSieve* prime_sieve_alloc(void) {
+    PrimeSieve* sieve = malloc(sizeof(PrimeSieve));
+    sieve->window_start = 1;
+    sieve->window_end = 1; // Empty, the first query sieves a window
+    sieve->base_primes = NULL;
+    sieve->num_base_primes = 0;
+    sieve->base_primes_capacity = 0;
+    sieve->base_limit = 2;
+    return sieve;
+}
+
+void prime_sieve_free(PrimeSieve* sieve) {
+    free(sieve->base_primes);
+    free(sieve);
+}
+
+// Base primes only go up to 2^16, as that's enough to sieve the entire 32-bit range.
+// Those are few and small, so trial division by the previous ones is fast enough
+static void prime_sieve_extend_base_primes(PrimeSieve* sieve, uint32_t limit) {
+    limit = limit < UINT16_MAX ? limit : UINT16_MAX;
+    for(uint32_t n = sieve->base_limit + 1 + (sieve->base_limit % 2); n <= limit; n += 2) {
+        bool is_prime = true;
+        for(size_t i = 0; i < sieve->num_base_primes; i++) {
+            const uint32_t q = sieve->base_primes[i];
+            if(q * q > n) {
+                break;
+            }
+            if(n % q == 0) {
+                is_prime = false;
+                break;
+            }
+        }
+        if(is_prime) {
+            if(sieve->num_base_primes == sieve->base_primes_capacity) {
+                sieve->base_primes_capacity =
+                    sieve->base_primes_capacity != 0 ? sieve->base_primes_capacity * 2 : 64;
+                sieve->base_primes = realloc(
+                    sieve->base_primes, sieve->base_primes_capacity * sizeof(uint16_t));
+            }
+            sieve->base_primes[sieve->num_base_primes++] = n;
+        }
+    }
+    if(limit > sieve->base_limit) {
+        sieve->base_limit = limit;
+    }
+}
+
+static void prime_sieve_sieve_window(PrimeSieve* sieve, uint32_t start) {
+    start |= 1;
+    const uint64_t end = (uint64_t)start + PRIME_SIEVE_WINDOW;
+    sieve->window_start = start;
+    sieve->window_end = end;
+
+    uint32_t limit = sieve->base_limit;
+    while((uint64_t)limit * limit < end) {
+        limit *= 2;
+    }
+    prime_sieve_extend_base_primes(sieve, limit);
+
+    memset(sieve->composite, 0, sizeof(sieve->composite));
+    if(start == 1) {
+        sieve->composite[0] |= 1;
+    }
+    for(size_t i = 0; i < sieve->num_base_primes; i++) {
+        const uint64_t q = sieve->base_primes[i];
+        if(q * q >= end) {
+            break;
+        }
+        // Start at the first odd multiple in the window, but never below q^2 so q itself stays prime
+        uint64_t multiple = q * q;
+        if(multiple < start) {
+            multiple = (start + q - 1) / q * q;
+            if(multiple % 2 == 0) {
+                multiple += q;
+            }
+        }
+        for(; multiple < end; multiple += 2 * q) {
+            const uint32_t bit = (multiple - start) / 2;
+            sieve->composite[bit / 8] |= 1 << (bit % 8);
+        }
+    }
+}
+
+uint32_t prime_sieve_next(PrimeSieve* sieve, uint32_t n) {
+    if(n <= 2) {
+        return 2;
+    }
+    n |= 1;
+    if(n < sieve->window_start || n >= sieve->window_end) {
+        prime_sieve_sieve_window(sieve, n);
+    }
+
+    for(;;) {
+        for(uint32_t bit = (n - sieve->window_start) / 2; bit < PRIME_SIEVE_WINDOW / 2; bit++) {
+            if((sieve->composite[bit / 8] & (1 << (bit % 8))) == 0) {
+                return sieve->window_start + bit * 2;
+            }
+        }
+        n = sieve->window_end;
+        prime_sieve_sieve_window(sieve, n);
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Segmented sieve of Eratosthenes, for walking the primes in order without testing each candidate
+// from scratch. Only one window of numbers is sieved at a time, so memory use stays small.
+typedef struct PrimeSieve PrimeSieve;
+
+PrimeSieve* prime_sieve_alloc(void);
+
+void prime_sieve_free(PrimeSieve* sieve);
+
+// Returns the smallest prime >= n. Walking up from the previous result stays within the sieved
+// window, jumping elsewhere repositions the sieve at the cost of sieving one window
+uint32_t prime_sieve_next(PrimeSieve* sieve, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
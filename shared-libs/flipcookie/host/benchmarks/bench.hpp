@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Minimal microbenchmark harness. Benchmarks register themselves at static initialization,
+// and flipcookie_benchmarks runs all of them, or only those whose names are passed on
+// the command line. Each one times any number of loops and reports them by label:
+//   BENCHMARK(frame_allocation) {
+//       cookie::bench::measure("PooledTask", 1000000, [] { ... });
+//   }
+// Iteration counts are scaled down by --quick, which ctest uses to check that they still run.
+namespace cookie::bench {
+
+struct Benchmark {
+    const char* name;
+    void (*func)();
+    Benchmark* next;
+};
+
+bool register_benchmark(Benchmark& benchmark);
+
+// Scales the iteration count, always returning at least 1
+uint64_t iterations(uint64_t count);
+
+void report(const char* label, uint64_t count, std::chrono::nanoseconds elapsed);
+void report_value(const char* label, double value, const char* unit);
+
+// Keeps the compiler from optimizing away a computed value
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Times func(), called iterations(count) times, and reports the time per call
+template <typename Func>
+void measure(const char* label, uint64_t count, Func&& func) {
+    count = iterations(count);
+    const auto start = std::chrono::steady_clock::now();
+    for(uint64_t i = 0; i < count; i++) {
+        func();
+    }
+    report(label, count, std::chrono::steady_clock::now() - start);
+}
+
+}
+
+#define BENCHMARK(name)                                                                      \
+    static void benchmark_##name();                                                          \
+    static cookie::bench::Benchmark benchmark_case_##name{#name, benchmark_##name, nullptr}; \
+    [[maybe_unused]] static const bool benchmark_registered_##name =                         \
+        cookie::bench::register_benchmark(benchmark_case_##name);                            \
+    static void benchmark_##name()
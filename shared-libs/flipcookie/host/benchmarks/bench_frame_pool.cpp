@@ -0,0 +1,49 @@
+// Coroutine frames taken from a FramePool against the global operator new (malloc). This tracks
+// the cost of the pool, it is not expected to win - see the notes in <frame_pool>.
+
+#include "bench.hpp"
+
+#include <cookie/coroutine>
+#include <cookie/frame_pool>
+
+#include <cstdlib>
+
+namespace {
+
+cookie::FramePool<128, 4> g_pool;
+
+cookie::Task<int> HeapTask(int value) {
+    co_return value + 1;
+}
+
+cookie::PooledTask<g_pool, int> PoolTask(int value) {
+    co_return value + 1;
+}
+
+}
+
+BENCHMARK(frame_allocation) {
+    int value = 0;
+    cookie::bench::measure("Task, global operator new", 10000000, [&value] {
+        cookie::Task<int> task = HeapTask(value);
+        value = *task.try_take_result();
+    });
+    cookie::bench::measure("PooledTask, FramePool", 10000000, [&value] {
+        cookie::PooledTask<g_pool, int> task = PoolTask(value);
+        value = *task.try_take_result();
+    });
+    cookie::bench::do_not_optimize(value);
+
+    // The allocators alone. On the host, the pool's critical section is a mutex
+    // rather than masked interrupts, which accounts for most of its cost here.
+    cookie::bench::measure("malloc and free", 10000000, [] {
+        void* ptr = std::malloc(128);
+        cookie::bench::do_not_optimize(ptr);
+        std::free(ptr);
+    });
+    cookie::bench::measure("FramePool allocate and deallocate", 10000000, [] {
+        void* ptr = g_pool.allocate(128);
+        cookie::bench::do_not_optimize(ptr);
+        g_pool.deallocate(ptr);
+    });
+}
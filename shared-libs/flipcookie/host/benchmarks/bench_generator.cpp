@@ -0,0 +1,120 @@
+// Generators against a hand-written iterator producing the same sequence
+
+#include "bench.hpp"
+
+#include <cookie/frame_pool>
+#include <cookie/generator>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace {
+
+constexpr uint32_t SEQUENCE_LENGTH = 16;
+
+cookie::FramePool<128, 2> g_pool;
+
+// Every value of the sequence is touched the same way, so the loops can't be folded away
+template <typename Range>
+uint32_t sum(Range&& range) {
+    uint32_t total = 0;
+    for(uint32_t value : range) {
+        cookie::bench::do_not_optimize(value);
+        total += value;
+    }
+    return total;
+}
+
+// The sequence as a plain range, the way it would be written without coroutines
+class Counter {
+public:
+    class iterator {
+    public:
+        using value_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(uint32_t value)
+            : m_value(value) {
+        }
+
+        uint32_t operator*() const {
+            return m_value;
+        }
+
+        iterator& operator++() {
+            m_value++;
+            return *this;
+        }
+
+        bool operator==(const iterator&) const = default;
+
+    private:
+        uint32_t m_value = 0;
+    };
+
+    Counter(uint32_t first, uint32_t last)
+        : m_first(first)
+        , m_last(last) {
+    }
+
+    iterator begin() const {
+        return iterator(m_first);
+    }
+
+    iterator end() const {
+        return iterator(m_last);
+    }
+
+private:
+    uint32_t m_first;
+    uint32_t m_last;
+};
+
+cookie::Generator<uint32_t> HeapCounter(uint32_t first, uint32_t last) {
+    for(uint32_t value = first; value != last; value++) {
+        co_yield value;
+    }
+}
+
+cookie::PooledGenerator<g_pool, uint32_t> PoolCounter(uint32_t first, uint32_t last) {
+    for(uint32_t value = first; value != last; value++) {
+        co_yield value;
+    }
+}
+
+cookie::Generator<uint32_t> EndlessCounter() {
+    for(uint32_t value = 0;; value++) {
+        co_yield value;
+    }
+}
+
+}
+
+BENCHMARK(generator_iteration) {
+    uint32_t total = 0;
+
+    // Creating, running through and destroying a short sequence
+    cookie::bench::measure("hand-written iterator, 16 values", 1000000, [&total] {
+        total += sum(Counter(0, SEQUENCE_LENGTH));
+    });
+    cookie::bench::measure("Generator, 16 values", 1000000, [&total] {
+        total += sum(HeapCounter(0, SEQUENCE_LENGTH));
+    });
+    cookie::bench::measure("PooledGenerator, 16 values", 1000000, [&total] {
+        total += sum(PoolCounter(0, SEQUENCE_LENGTH));
+    });
+
+    {
+        // A single value from a generator that is already running
+        cookie::Generator<uint32_t> generator = EndlessCounter();
+        auto it = generator.begin();
+        cookie::bench::measure("Generator, next value", 10000000, [&total, &it] {
+            total += *it;
+            ++it;
+        });
+    }
+
+    cookie::bench::do_not_optimize(total);
+}
@@ -0,0 +1,67 @@
+// SpscRing throughput, on a single thread and between a producer and a consumer thread
+
+#include "bench.hpp"
+
+#include <cookie/spsc_ring>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+using Ring = cookie::SpscRing<uint32_t, 256>;
+
+}
+
+BENCHMARK(spsc_ring_throughput) {
+    {
+        // The cost of the ring operations alone, with nothing contending for the indices
+        Ring ring;
+        uint32_t value = 0;
+        cookie::bench::measure("push and pop, one thread", 10000000, [&ring, &value] {
+            ring.push(value);
+            ring.pop(value);
+            value++;
+        });
+        cookie::bench::do_not_optimize(value);
+    }
+
+    {
+        // Items handed over between threads, the producer retrying whenever the ring is full
+        Ring ring;
+        const uint64_t count = cookie::bench::iterations(10000000);
+        std::atomic<bool> producer_done{false};
+        uint64_t sum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        std::thread producer([&] {
+            for(uint64_t i = 0; i < count; i++) {
+                while(!ring.push(static_cast<uint32_t>(i))) {
+                    std::this_thread::yield();
+                }
+            }
+            producer_done.store(true, std::memory_order_release);
+        });
+        for(;;) {
+            const bool done = producer_done.load(std::memory_order_acquire);
+            const std::size_t consumed =
+                ring.consume_all([&sum](const uint32_t* items, std::size_t count) {
+                    for(std::size_t i = 0; i < count; i++) {
+                        sum += items[i];
+                    }
+                });
+            if(done && ring.empty()) {
+                break;
+            }
+            if(consumed == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        cookie::bench::report(
+            "push, consume_all on another thread", count, std::chrono::steady_clock::now() - start);
+        cookie::bench::do_not_optimize(sum);
+    }
+}
@@ -0,0 +1,72 @@
+// Costs of the task machinery itself, with nothing but the coroutines involved
+
+#include "bench.hpp"
+
+#include <cookie/coroutine>
+
+#include <coroutine>
+
+namespace {
+
+// Suspends the awaiting coroutine and hands its handle to the driver
+struct Suspend {
+    std::coroutine_handle<>* handle;
+
+    bool await_ready() const {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> h) {
+        *handle = h;
+    }
+
+    void await_resume() const {
+    }
+};
+
+cookie::Task<int> Immediate(int value) {
+    co_return value;
+}
+
+cookie::Task<int> Suspending(std::coroutine_handle<>* handle, int value) {
+    co_await Suspend{handle};
+    co_return value;
+}
+
+}
+
+BENCHMARK(task_resume_cost) {
+    cookie::bench::measure("create and finish a Task", 10000000, [] {
+        cookie::Task<int> task = Immediate(1);
+        cookie::bench::do_not_optimize(task.try_take_result());
+    });
+
+    {
+        // A single long-lived task, suspended and resumed over and over
+        std::coroutine_handle<> handle;
+        auto loop = [&handle]() -> cookie::Task<> {
+            for(;;) {
+                co_await Suspend{&handle};
+            }
+        };
+        cookie::Task<> task = loop();
+        cookie::bench::measure(
+            "resume a suspended Task", 10000000, [&handle] { handle.resume(); });
+    }
+
+    {
+        // The parent awaits a child that suspends, the child's resumption finishes both
+        std::coroutine_handle<> handle;
+        int sum = 0;
+        auto parent = [&handle, &sum]() -> cookie::Task<> {
+            for(;;) {
+                sum += co_await Suspending(&handle, 1);
+            }
+        };
+        cookie::Task<> task = parent();
+        cookie::bench::measure("create, await and resume a child Task", 10000000, [&handle] {
+            handle.resume();
+        });
+        cookie::bench::do_not_optimize(sum);
+    }
+}
@@ -0,0 +1,46 @@
+// Wall time of waking up a coroutine from an AwaitableTimer. The delays themselves take no time,
+// as the host time is virtual, so this measures the cost of the wake-up path alone.
+
+#include "bench.hpp"
+
+#include <furi.h>
+
+#include <cookie/coroutine>
+#include <cookie/event_loop>
+#include <cookie/executor>
+#include <cookie/timer>
+
+template <typename Timer>
+static void measure_wakes(
+    const char* label,
+    uint64_t wakes,
+    ::FuriEventLoop* event_loop,
+    Timer& timer) {
+    const uint64_t count = cookie::bench::iterations(wakes);
+    auto wait = [&]() -> cookie::Task<> {
+        for(uint64_t i = 0; i < count; i++) {
+            co_await timer.await_delay(1);
+        }
+        furi_event_loop_stop(event_loop);
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    cookie::Task<> task = wait();
+    furi_event_loop_run(event_loop);
+    cookie::bench::report(label, count, std::chrono::steady_clock::now() - start);
+}
+
+BENCHMARK(timer_wake_latency) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        cookie::AwaitableTimer<cookie::FuriEventLoopTimer> timer(event_loop);
+        measure_wakes("FuriEventLoopTimer", 1000000, event_loop, timer);
+    }
+    {
+        // Hops from the timer thread to the event loop on every wake
+        cookie::AwaitableTimer<cookie::FuriTimer, cookie::EventLoopExecutor> timer(
+            cookie::EventLoopExecutor{event_loop});
+        measure_wakes("FuriTimer, EventLoopExecutor", 20000, event_loop, timer);
+    }
+    furi_event_loop_free(event_loop);
+}
@@ -0,0 +1,145 @@
+// Thousands of timers on a TimerWheel against as many FuriEventLoopTimers: restarting them,
+// and running them all to expiry. Every run crosses the point where the 32-bit tick wraps around.
+
+#include "bench.hpp"
+
+#include <furi.h>
+
+#include <cookie/event_loop>
+#include <cookie/timer_wheel>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <random>
+
+namespace {
+
+constexpr uint32_t TIMER_COUNT = 4000;
+constexpr uint32_t MAX_INTERVAL = 4000;
+
+struct Restart {
+    uint32_t index;
+    uint32_t interval;
+};
+
+// The same timers and intervals for both kinds of timers
+std::array<Restart, 4096> make_restarts() {
+    std::mt19937 random(4000);
+    std::uniform_int_distribution<uint32_t> index(0, TIMER_COUNT - 1);
+    std::uniform_int_distribution<uint32_t> interval(1, MAX_INTERVAL);
+
+    std::array<Restart, 4096> restarts;
+    for(Restart& restart : restarts) {
+        restart = {index(random), interval(random)};
+    }
+    return restarts;
+}
+
+// Counts the expired timers, and how many distinct ticks they expired on
+struct Drain {
+    FuriEventLoop* event_loop;
+    uint32_t remaining = 0;
+    uint32_t last_tick = 0;
+    uint32_t wakeups = 0;
+
+    static void callback(void* context) {
+        Drain* drain = reinterpret_cast<Drain*>(context);
+        const uint32_t now = furi_get_tick();
+        if(now != drain->last_tick) {
+            drain->last_tick = now;
+            drain->wakeups++;
+        }
+        if(--drain->remaining == 0) {
+            furi_event_loop_stop(drain->event_loop);
+        }
+    }
+};
+
+void move_before_tick_wrap() {
+    furi_host_advance_ticks(0U - furi_get_tick() - MAX_INTERVAL / 2);
+}
+
+// start(timer, interval) restarts a timer if it's already running, stop(timer) stops it
+template <typename Timers, typename Start, typename Stop>
+void measure_timers(const char* name, Drain& drain, Timers& timers, Start start, Stop stop) {
+    static const std::array<Restart, 4096> restarts = make_restarts();
+    char label[64];
+
+    // Restarting timers that are already running, which is what most timeouts end up doing
+    move_before_tick_wrap();
+    for(auto& timer : timers) {
+        start(timer, MAX_INTERVAL);
+    }
+    uint32_t next = 0;
+    std::snprintf(label, sizeof(label), "%s, restart", name);
+    cookie::bench::measure(label, 1000000, [&] {
+        const Restart& restart = restarts[next++ % restarts.size()];
+        start(timers[restart.index], restart.interval);
+    });
+    for(auto& timer : timers) {
+        stop(timer);
+    }
+
+    // Starting all of them and running the loop until every one has expired
+    const uint64_t rounds = cookie::bench::iterations(100);
+    uint64_t wakeups = 0;
+    std::chrono::nanoseconds elapsed{};
+    for(uint64_t round = 0; round < rounds; round++) {
+        move_before_tick_wrap();
+        drain.remaining = TIMER_COUNT;
+        drain.wakeups = 0;
+
+        const auto start_time = std::chrono::steady_clock::now();
+        for(uint32_t i = 0; i < TIMER_COUNT; i++) {
+            start(timers[i], restarts[i].interval);
+        }
+        furi_event_loop_run(drain.event_loop);
+        elapsed += std::chrono::steady_clock::now() - start_time;
+        wakeups += drain.wakeups;
+    }
+    std::snprintf(label, sizeof(label), "%s, start and expire", name);
+    cookie::bench::report(label, rounds * TIMER_COUNT, elapsed);
+    std::snprintf(label, sizeof(label), "%s, distinct expiry ticks", name);
+    cookie::bench::report_value(label, static_cast<double>(wakeups) / rounds, "ticks");
+}
+
+}
+
+BENCHMARK(timer_wheel_many_timers) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    Drain drain{event_loop};
+
+    {
+        cookie::TimerWheel wheel(event_loop);
+        std::deque<cookie::TimerWheelTimer> timers;
+        for(uint32_t i = 0; i < TIMER_COUNT; i++) {
+            timers.emplace_back(wheel, Drain::callback, &drain);
+        }
+        measure_timers(
+            "TimerWheel",
+            drain,
+            timers,
+            [](cookie::TimerWheelTimer& timer, uint32_t interval) { timer.start(interval); },
+            [](cookie::TimerWheelTimer& timer) { timer.stop(); });
+    }
+
+    {
+        std::deque<cookie::FuriEventLoopTimer> timers;
+        for(uint32_t i = 0; i < TIMER_COUNT; i++) {
+            timers.emplace_back(event_loop, Drain::callback, FuriEventLoopTimerTypeOnce, &drain);
+        }
+        measure_timers(
+            "FuriEventLoopTimer",
+            drain,
+            timers,
+            [](cookie::FuriEventLoopTimer& timer, uint32_t interval) {
+                furi_event_loop_timer_start(*timer, interval);
+            },
+            [](cookie::FuriEventLoopTimer& timer) { furi_event_loop_timer_stop(*timer); });
+    }
+
+    furi_event_loop_free(event_loop);
+}
@@ -0,0 +1,78 @@
+// Reading a view model the way a draw callback does: a seqlock model against a locking one,
+// alone and with another thread updating the model all the time
+
+#include "bench.hpp"
+
+#include <cookie/gui/view>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+struct LockingBlock {
+    uint32_t words[16];
+};
+
+struct SeqlockBlock {
+    using is_seqlock = void;
+
+    uint32_t words[16];
+};
+
+// Keeps updating the model until destroyed
+template <typename Block>
+class Writer {
+public:
+    explicit Writer(View* view)
+        : m_thread([this, view] {
+            for(uint32_t i = 0; !m_stop.load(std::memory_order_relaxed); i++) {
+                cookie::with_view_model(view, [i](Block& block) {
+                    for(uint32_t& word : block.words) {
+                        word = i;
+                    }
+                });
+            }
+        }) {
+    }
+
+    ~Writer() {
+        m_stop.store(true, std::memory_order_relaxed);
+        m_thread.join();
+    }
+
+private:
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+};
+
+template <typename Block>
+void measure_reads(const char* label, View* view) {
+    uint32_t sum = 0;
+    cookie::bench::measure(label, 10000000, [view, &sum] {
+        void* model = view_get_model(view);
+        const Block block = cookie::view_model_snapshot<Block>(model);
+        view_commit_model(view, false);
+        sum += block.words[0];
+    });
+    cookie::bench::do_not_optimize(sum);
+}
+
+}
+
+BENCHMARK(view_model_read) {
+    cookie::ViewModel<LockingBlock> locking_view;
+    cookie::ViewModel<SeqlockBlock> seqlock_view;
+
+    measure_reads<LockingBlock>("locking model", *locking_view);
+    measure_reads<SeqlockBlock>("seqlock model", *seqlock_view);
+    {
+        Writer<LockingBlock> writer(*locking_view);
+        measure_reads<LockingBlock>("locking model, concurrent writer", *locking_view);
+    }
+    {
+        Writer<SeqlockBlock> writer(*seqlock_view);
+        measure_reads<SeqlockBlock>("seqlock model, concurrent writer", *seqlock_view);
+    }
+}
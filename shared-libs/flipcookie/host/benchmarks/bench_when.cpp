@@ -0,0 +1,75 @@
+// Cost of resuming a coroutine through when_any and when_all, against awaiting directly
+
+#include "bench.hpp"
+
+#include <cookie/coroutine>
+#include <cookie/when>
+
+#include <coroutine>
+
+namespace {
+
+// Suspends the awaiting coroutine and hands its handle to the driver
+struct Suspend {
+    std::coroutine_handle<>* handle;
+
+    bool await_ready() const {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> h) {
+        *handle = h;
+    }
+
+    void await_resume() const {
+    }
+};
+
+}
+
+BENCHMARK(when_resume_cost) {
+    std::coroutine_handle<> first, second;
+    uint32_t rounds = 0;
+
+    {
+        auto loop = [&]() -> cookie::Task<> {
+            for(;;) {
+                co_await Suspend{&first};
+                rounds++;
+            }
+        };
+        cookie::Task<> task = loop();
+        cookie::bench::measure("co_await, resume", 10000000, [&first] { first.resume(); });
+    }
+
+    {
+        // Every round sets up both helpers, the winner resumes the parent and the loser
+        // is destroyed before it does
+        auto loop = [&]() -> cookie::Task<> {
+            for(;;) {
+                co_await cookie::when_any(Suspend{&first}, Suspend{&second});
+                rounds++;
+            }
+        };
+        cookie::Task<> task = loop();
+        cookie::bench::measure("when_any of 2, resume the first", 10000000, [&first] {
+            first.resume();
+        });
+    }
+
+    {
+        auto loop = [&]() -> cookie::Task<> {
+            for(;;) {
+                co_await cookie::when_all(Suspend{&first}, Suspend{&second});
+                rounds++;
+            }
+        };
+        cookie::Task<> task = loop();
+        cookie::bench::measure("when_all of 2, resume both", 10000000, [&first, &second] {
+            first.resume();
+            second.resume();
+        });
+    }
+
+    cookie::bench::do_not_optimize(rounds);
+}
@@ -0,0 +1,61 @@
+#include "bench.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace cookie::bench {
+
+namespace {
+Benchmark* g_benchmarks = nullptr;
+Benchmark** g_benchmarks_tail = &g_benchmarks;
+uint64_t g_divisor = 1;
+}
+
+bool register_benchmark(Benchmark& benchmark) {
+    *g_benchmarks_tail = &benchmark;
+    g_benchmarks_tail = &benchmark.next;
+    return true;
+}
+
+uint64_t iterations(uint64_t count) {
+    return count >= g_divisor ? count / g_divisor : 1;
+}
+
+void report(const char* label, uint64_t count, std::chrono::nanoseconds elapsed) {
+    std::printf(
+        "  %-40s %12llu iterations %10.2f ns/iteration\n",
+        label,
+        static_cast<unsigned long long>(count),
+        static_cast<double>(elapsed.count()) / static_cast<double>(count));
+}
+
+void report_value(const char* label, double value, const char* unit) {
+    std::printf("  %-40s %12.2f %s\n", label, value, unit);
+}
+
+}
+
+using namespace cookie::bench;
+
+int main(int argc, char** argv) {
+    int first_name = 1;
+    if(argc > 1 && std::strcmp(argv[1], "--quick") == 0) {
+        g_divisor = 1000;
+        first_name = 2;
+    }
+
+    for(Benchmark* benchmark = g_benchmarks; benchmark != nullptr; benchmark = benchmark->next) {
+        bool selected = first_name == argc;
+        for(int i = first_name; i < argc; i++) {
+            selected |= std::strcmp(argv[i], benchmark->name) == 0;
+        }
+        if(!selected) {
+            continue;
+        }
+
+        std::printf("%s\n", benchmark->name);
+        std::fflush(stdout);
+        benchmark->func();
+    }
+    return 0;
+}
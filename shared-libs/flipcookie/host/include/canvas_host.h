@@ -0,0 +1,61 @@
+/**
+ * @file canvas_host.h
+ * Controls of the host canvas that have no Furi counterpart.
+ *
+ * On the host, the code under test draws into a canvas owned by the test harness, typically
+ * by passing it to view_draw. The harness can then inspect the pixels, export them as a PBM
+ * image, compare them against a previously exported one, and see how many drawing calls
+ * it took to produce them.
+ */
+#pragma once
+
+#include <gui/canvas.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    /** Calls to any of the canvas_draw_* functions, canvas_clear included */
+    uint32_t draw_calls;
+    /** Pixels written by those calls, after clipping */
+    uint32_t pixels_drawn;
+    /** Calls to canvas_commit */
+    uint32_t commits;
+} CanvasHostStatistics;
+
+Canvas* canvas_host_alloc(void);
+
+void canvas_host_free(Canvas* canvas);
+
+/** True if the pixel is set (black). Pixels outside the canvas are clear. */
+bool canvas_host_get_pixel(const Canvas* canvas, int32_t x, int32_t y);
+
+/**
+ * The frame buffer, in the same layout as the raster of a binary PBM image:
+ * rows top to bottom, 8 pixels per byte, most significant bit first
+ */
+const uint8_t* canvas_host_get_buffer(const Canvas* canvas);
+
+size_t canvas_host_get_buffer_size(const Canvas* canvas);
+
+CanvasHostStatistics canvas_host_get_statistics(const Canvas* canvas);
+
+void canvas_host_reset_statistics(Canvas* canvas);
+
+/** Writes the canvas contents to a binary (P4) PBM file */
+bool canvas_host_save_pbm(const Canvas* canvas, const char* path);
+
+/**
+ * Compares the canvas contents against a binary PBM file of the same size.
+ * Returns the number of mismatching pixels, or -1 if the file could not be read.
+ */
+int32_t canvas_host_compare_pbm(const Canvas* canvas, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,18 @@
+/**
+ * @file furi.h
+ * Host emulation of the Furi core, for building and profiling flipcookie natively
+ */
+#pragma once
+
+#include <furi/core/base.h>
+#include <furi/core/check.h>
+#include <furi/core/common_defines.h>
+#include <furi/core/event_loop.h>
+#include <furi/core/event_loop_timer.h>
+#include <furi/core/kernel.h>
+#include <furi/core/message_queue.h>
+#include <furi/core/semaphore.h>
+#include <furi/core/thread.h>
+#include <furi/core/timer.h>
+
+#include <furi_host.h>
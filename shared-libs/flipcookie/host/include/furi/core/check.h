@@ -0,0 +1,26 @@
+/**
+ * @file check.h
+ * Host emulation of the Furi checks. Failed checks print the location and abort.
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Prints the message and location, then aborts */
+__attribute__((noreturn)) void
+    __furi_host_crash(const char* message, const char* expression, const char* file, int line);
+
+#define furi_crash(message) __furi_host_crash((message), NULL, __FILE__, __LINE__)
+
+#define furi_halt(message) furi_crash(message)
+
+#define furi_check(__e, ...) \
+    ((__e) ? (void)0 : __furi_host_crash("furi_check failed", #__e, __FILE__, __LINE__))
+
+#define furi_assert(__e, ...) furi_check(__e)
+
+#ifdef __cplusplus
+}
+#endif
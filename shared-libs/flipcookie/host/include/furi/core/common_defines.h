@@ -0,0 +1,62 @@
+/**
+ * @file common_defines.h
+ * Host emulation of the Furi common defines
+ */
+#pragma once
+
+#include "kernel.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef FURI_ALWAYS_INLINE
+#define FURI_ALWAYS_INLINE __attribute__((always_inline)) inline
+#endif
+
+#ifndef FURI_NOINLINE
+#define FURI_NOINLINE __attribute__((noinline))
+#endif
+
+#ifndef FURI_WARN_UNUSED
+#define FURI_WARN_UNUSED __attribute__((warn_unused_result))
+#endif
+
+#ifndef FURI_PACKED
+#define FURI_PACKED __attribute__((packed))
+#endif
+
+#ifndef UNUSED
+#define UNUSED(X) (void)(X)
+#endif
+
+#ifndef COUNT_OF
+#define COUNT_OF(x) (sizeof(x) / sizeof(x[0]))
+#endif
+
+typedef struct {
+    uint32_t isrm;
+    bool from_isr;
+    bool kernel_running;
+} __FuriCriticalInfo;
+
+/** Critical sections are emulated with a single process-wide recursive mutex */
+__FuriCriticalInfo __furi_critical_enter(void);
+
+void __furi_critical_exit(__FuriCriticalInfo info);
+
+#ifndef FURI_CRITICAL_ENTER
+#define FURI_CRITICAL_ENTER() __FuriCriticalInfo __furi_critical_info = __furi_critical_enter();
+#endif
+
+#ifndef FURI_CRITICAL_EXIT
+#define FURI_CRITICAL_EXIT() __furi_critical_exit(__furi_critical_info);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
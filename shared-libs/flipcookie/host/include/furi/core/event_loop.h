@@ -0,0 +1,77 @@
+/**
+ * @file event_loop.h
+ * Host emulation of the Furi event loop. When a loop runs out of work, the virtual time
+ * may skip ahead to the nearest timer, see furi_host.h.
+ */
+#pragma once
+
+#include "base.h"
+#include "message_queue.h"
+#include "semaphore.h"
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FuriEventLoopEventIn = 0x00000001U,
+    FuriEventLoopEventOut = 0x00000002U,
+    FuriEventLoopEventMask = 0x00000003U,
+
+    /** Only call back when the object changes state, instead of as long as it's ready */
+    FuriEventLoopEventFlagEdge = 0x00000004U,
+    /** Unsubscribe automatically after the first callback */
+    FuriEventLoopEventFlagOnce = 0x00000008U,
+    FuriEventLoopEventFlagMask = 0xFFFFFFFCU,
+
+    FuriEventLoopEventReserved = UINT32_MAX,
+} FuriEventLoopEvent;
+
+typedef struct FuriEventLoop FuriEventLoop;
+
+typedef void FuriEventLoopObject;
+
+typedef void (*FuriEventLoopEventCallback)(FuriEventLoopObject* object, void* context);
+
+typedef void (*FuriEventLoopPendingCallback)(void* context);
+
+/** The loop belongs to the thread allocating it */
+FuriEventLoop* furi_event_loop_alloc(void);
+
+void furi_event_loop_free(FuriEventLoop* instance);
+
+/** Runs until furi_event_loop_stop is called */
+void furi_event_loop_run(FuriEventLoop* instance);
+
+/** Can be called from any thread */
+void furi_event_loop_stop(FuriEventLoop* instance);
+
+/** Can be called from any thread. Callbacks run in the order they were pended. */
+void furi_event_loop_pend_callback(
+    FuriEventLoop* instance,
+    FuriEventLoopPendingCallback callback,
+    void* context);
+
+void furi_event_loop_subscribe_semaphore(
+    FuriEventLoop* instance,
+    FuriSemaphore* semaphore,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* message_queue,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, FuriEventLoopObject* object);
+
+bool furi_event_loop_is_subscribed(FuriEventLoop* instance, FuriEventLoopObject* object);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,34 @@
+/**
+ * @file kernel.h
+ * Host emulation of the Furi kernel. Ticks are virtual, see furi_host.h.
+ */
+#pragma once
+
+#include "base.h"
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** There are no interrupts on the host, so this is always false */
+bool furi_kernel_is_irq_or_masked(void);
+
+bool furi_kernel_is_running(void);
+
+/** Virtual tick count. Runs at 1000 ticks per second of virtual time. */
+uint32_t furi_get_tick(void);
+
+uint32_t furi_kernel_get_tick_frequency(void);
+
+uint32_t furi_ms_to_ticks(uint32_t milliseconds);
+
+/** Waits until the virtual time reaches the current tick plus ticks */
+void furi_delay_tick(uint32_t ticks);
+
+void furi_delay_ms(uint32_t milliseconds);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,74 @@
+/**
+ * @file thread.h
+ * Host emulation of Furi threads, backed by std::thread. Priorities and stack sizes
+ * are accepted, but have no effect.
+ */
+#pragma once
+
+#include "base.h"
+#include "common_defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FuriThreadStateStopped,
+    FuriThreadStateStarting,
+    FuriThreadStateRunning,
+} FuriThreadState;
+
+typedef enum {
+    FuriThreadPriorityNone = 0,
+    FuriThreadPriorityIdle = 1,
+    FuriThreadPriorityLowest = 14,
+    FuriThreadPriorityLow = 15,
+    FuriThreadPriorityNormal = 16,
+    FuriThreadPriorityHigh = 17,
+    FuriThreadPriorityHighest = 18,
+    FuriThreadPriorityIsr = 31,
+} FuriThreadPriority;
+
+typedef struct FuriThread FuriThread;
+
+typedef void* FuriThreadId;
+
+typedef int32_t (*FuriThreadCallback)(void* context);
+
+FuriThread* furi_thread_alloc(void);
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context);
+
+/** The thread must not be running */
+void furi_thread_free(FuriThread* thread);
+
+void furi_thread_set_name(FuriThread* thread, const char* name);
+
+void furi_thread_set_stack_size(FuriThread* thread, size_t stack_size);
+
+void furi_thread_set_callback(FuriThread* thread, FuriThreadCallback callback);
+
+void furi_thread_set_context(FuriThread* thread, void* context);
+
+void furi_thread_set_priority(FuriThread* thread, FuriThreadPriority priority);
+
+FuriThreadState furi_thread_get_state(FuriThread* thread);
+
+void furi_thread_start(FuriThread* thread);
+
+bool furi_thread_join(FuriThread* thread);
+
+int32_t furi_thread_get_return_code(FuriThread* thread);
+
+/** Unique per host thread, including the ones not created with furi_thread_alloc */
+FuriThreadId furi_thread_get_current_id(void);
+
+void furi_thread_yield(void);
+
+#ifdef __cplusplus
+}
+#endif
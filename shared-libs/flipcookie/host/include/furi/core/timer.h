@@ -0,0 +1,40 @@
+/**
+ * @file timer.h
+ * Host emulation of Furi timers. Callbacks run on a shared timer thread, like on the device.
+ */
+#pragma once
+
+#include "base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*FuriTimerCallback)(void* context);
+
+typedef enum {
+    FuriTimerTypeOnce = 0,
+    FuriTimerTypePeriodic = 1,
+} FuriTimerType;
+
+typedef struct FuriTimer FuriTimer;
+
+FuriTimer* furi_timer_alloc(FuriTimerCallback func, FuriTimerType type, void* context);
+
+/** Waits for the callback to finish if it's running right now */
+void furi_timer_free(FuriTimer* instance);
+
+/** Restarts the timer if it's already running. Intervals are in virtual ticks. */
+FuriStatus furi_timer_start(FuriTimer* instance, uint32_t ticks);
+
+FuriStatus furi_timer_restart(FuriTimer* instance, uint32_t ticks);
+
+FuriStatus furi_timer_stop(FuriTimer* instance);
+
+uint32_t furi_timer_is_running(FuriTimer* instance);
+
+uint32_t furi_timer_get_expire_time(FuriTimer* instance);
+
+#ifdef __cplusplus
+}
+#endif
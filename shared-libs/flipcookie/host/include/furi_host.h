@@ -0,0 +1,35 @@
+/**
+ * @file furi_host.h
+ * Controls of the host emulation that have no Furi counterpart.
+ *
+ * Time on the host is virtual: furi_get_tick() only moves forward when the emulation advances it.
+ * By default, it does so automatically: when a thread blocks waiting for an event loop, a timeout
+ * or a delay, and every running event loop, Furi thread and the timer thread is out of work too,
+ * the time skips straight to the nearest deadline. A program built on event loops and timers
+ * then runs as fast as the host allows, regardless of how long its delays are.
+ *
+ * Threads not created with furi_thread_alloc (like the main thread) are invisible to this,
+ * and time may skip ahead while they are busy. Tests relying on those can disable automatic
+ * advancing and step the time manually.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Enables or disables skipping the time ahead when there is nothing to do. Enabled by default. */
+void furi_host_set_auto_advance(bool enable);
+
+/** Moves the virtual time forward, firing every timer that expires on the way */
+void furi_host_advance_ticks(uint32_t ticks);
+
+/** Virtual time elapsed since the start of the program, which never wraps around */
+uint64_t furi_host_get_tick64(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,126 @@
+/**
+ * @file canvas.h
+ * Host emulation of the GUI canvas: a 128x64 monochrome frame buffer with the drawing primitives
+ * the apps use. Host-specific controls, like allocating a canvas or exporting its contents,
+ * are in canvas_host.h.
+ *
+ * Text is drawn with a built-in 5x7 font, so it does not match the device fonts pixel for pixel.
+ * All the fonts share it.
+ */
+#pragma once
+
+#include <gui/icon.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ColorWhite = 0x00,
+    ColorBlack = 0x01,
+    ColorXOR = 0x02,
+} Color;
+
+typedef enum {
+    FontPrimary,
+    FontSecondary,
+    FontKeyboard,
+    FontBigNumbers,
+
+    FontTotalNumber,
+} Font;
+
+typedef enum {
+    AlignLeft,
+    AlignRight,
+    AlignTop,
+    AlignBottom,
+    AlignCenter,
+} Align;
+
+typedef struct Canvas Canvas;
+
+/** Clears the canvas and restores the default color and font */
+void canvas_reset(Canvas* canvas);
+
+/** Counts a frame as presented, the canvas contents are kept */
+void canvas_commit(Canvas* canvas);
+
+size_t canvas_width(const Canvas* canvas);
+
+size_t canvas_height(const Canvas* canvas);
+
+size_t canvas_current_font_height(const Canvas* canvas);
+
+void canvas_clear(Canvas* canvas);
+
+void canvas_set_color(Canvas* canvas, Color color);
+
+void canvas_invert_color(Canvas* canvas);
+
+void canvas_set_font(Canvas* canvas, Font font);
+
+/** Draws a string with its baseline at y */
+void canvas_draw_str(Canvas* canvas, int32_t x, int32_t y, const char* str);
+
+void canvas_draw_str_aligned(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    Align horizontal,
+    Align vertical,
+    const char* str);
+
+uint16_t canvas_string_width(Canvas* canvas, const char* str);
+
+/** Horizontal advance of a glyph, including the spacing after it */
+size_t canvas_glyph_width(Canvas* canvas, uint16_t symbol);
+
+void canvas_draw_glyph(Canvas* canvas, int32_t x, int32_t y, uint16_t ch);
+
+/** In bitmap mode, bitmaps and icons are drawn transparently - their clear pixels are skipped */
+void canvas_set_bitmap_mode(Canvas* canvas, bool alpha);
+
+/** Only icons stored uncompressed are supported */
+void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon);
+
+/** Draws an XBM image: rows padded to whole bytes, least significant bit first */
+void canvas_draw_xbm(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap);
+
+void canvas_draw_dot(Canvas* canvas, int32_t x, int32_t y);
+
+void canvas_draw_box(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height);
+
+void canvas_draw_frame(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height);
+
+void canvas_draw_line(Canvas* canvas, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+
+void canvas_draw_rframe(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    size_t radius);
+
+void canvas_draw_rbox(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    size_t radius);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,29 @@
+/**
+ * @file elements.h
+ * Host emulation of the GUI elements, built on the canvas primitives like on the device
+ */
+#pragma once
+
+#include <gui/canvas.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Rounded frame with a 2 pixel thick border, filled white */
+void elements_bold_rounded_frame(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height);
+
+/** Draws text line by line, the first baseline at y */
+void elements_multiline_text(Canvas* canvas, int32_t x, int32_t y, const char* text);
+
+#ifdef __cplusplus
+}
+#endif
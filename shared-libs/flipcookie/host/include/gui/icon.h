@@ -0,0 +1,31 @@
+/**
+ * @file icon.h
+ * Host emulation of GUI icons, laid out like the ones generated from the app assets
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Every frame starts with a header byte, 0x00 for an uncompressed XBM image,
+ * or 0x01 for a compressed one
+ */
+typedef struct {
+    const uint16_t width;
+    const uint16_t height;
+    const uint8_t frame_count;
+    const uint8_t frame_rate;
+    const uint8_t* const* frames;
+} Icon;
+
+uint16_t icon_get_width(const Icon* instance);
+
+uint16_t icon_get_height(const Icon* instance);
+
+#ifdef __cplusplus
+}
+#endif
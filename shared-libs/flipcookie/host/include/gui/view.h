@@ -0,0 +1,91 @@
+/**
+ * @file view.h
+ * Host emulation of GUI views, covering the callbacks and the model storage.
+ * Drawing is done by calling view_draw with a host canvas.
+ */
+#pragma once
+
+#include <input/input.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VIEW_NONE  0xFFFFFFFF
+#define VIEW_IGNORE 0xFFFFFFFE
+
+typedef struct Canvas Canvas;
+
+typedef enum {
+    /** No model */
+    ViewModelTypeNone,
+    /** Model is shared between threads without any synchronization */
+    ViewModelTypeLockFree,
+    /** Model is guarded by a recursive mutex, held between view_get_model and view_commit_model */
+    ViewModelTypeLocking,
+} ViewModelType;
+
+typedef struct View View;
+
+typedef void (*ViewDrawCallback)(Canvas* canvas, void* model);
+
+typedef bool (*ViewInputCallback)(InputEvent* event, void* context);
+
+typedef bool (*ViewCustomCallback)(uint32_t event, void* context);
+
+typedef uint32_t (*ViewNavigationCallback)(void* context);
+
+typedef void (*ViewCallback)(void* context);
+
+typedef void (*ViewUpdateCallback)(View* view, void* context);
+
+View* view_alloc(void);
+
+void view_free(View* view);
+
+void view_set_update_callback(View* view, ViewUpdateCallback callback);
+
+void view_set_update_callback_context(View* view, void* context);
+
+void view_set_draw_callback(View* view, ViewDrawCallback callback);
+
+void view_set_input_callback(View* view, ViewInputCallback callback);
+
+void view_set_custom_callback(View* view, ViewCustomCallback callback);
+
+void view_set_previous_callback(View* view, ViewNavigationCallback callback);
+
+void view_set_enter_callback(View* view, ViewCallback callback);
+
+void view_set_exit_callback(View* view, ViewCallback callback);
+
+void view_set_context(View* view, void* context);
+
+void view_allocate_model(View* view, ViewModelType type, size_t size);
+
+void view_free_model(View* view);
+
+/** Locks locking models, the lock is released by view_commit_model */
+void* view_get_model(View* view);
+
+/** Unlocks locking models, and calls the update callback if update is set */
+void view_commit_model(View* view, bool update);
+
+/** The view dispatcher's part, provided for driving views on the host */
+void view_draw(View* view, Canvas* canvas);
+
+bool view_input(View* view, InputEvent* event);
+
+bool view_custom(View* view, uint32_t event);
+
+void view_enter(View* view);
+
+void view_exit(View* view);
+
+#ifdef __cplusplus
+}
+#endif
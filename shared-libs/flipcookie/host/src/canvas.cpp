@@ -0,0 +1,532 @@
+#include "font.hpp"
+
+#include <canvas_host.h>
+#include <furi/core/check.h>
+#include <furi/core/common_defines.h>
+#include <gui/canvas.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using cookie::host::Font5x7;
+
+struct Canvas {
+    static constexpr int32_t WIDTH = 128;
+    static constexpr int32_t HEIGHT = 64;
+    static constexpr int32_t STRIDE = WIDTH / 8;
+
+    uint8_t m_buffer[STRIDE * HEIGHT] = {};
+    Color m_color = ColorBlack;
+    Font m_font = FontSecondary;
+    bool m_bitmap_alpha = false;
+
+    CanvasHostStatistics m_statistics = {};
+
+    void draw_pixel(int32_t x, int32_t y, Color color) {
+        if(x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT) {
+            return;
+        }
+
+        uint8_t& byte = m_buffer[y * STRIDE + x / 8];
+        const uint8_t mask = 0x80 >> (x % 8);
+        switch(color) {
+        case ColorWhite:
+            byte &= ~mask;
+            break;
+        case ColorBlack:
+            byte |= mask;
+            break;
+        case ColorXOR:
+            byte ^= mask;
+            break;
+        }
+        m_statistics.pixels_drawn++;
+    }
+
+    void draw_pixel(int32_t x, int32_t y) {
+        draw_pixel(x, y, m_color);
+    }
+
+    void fill(int32_t x, int32_t y, int32_t width, int32_t height) {
+        // Clip first, so huge boxes don't cost anything extra
+        const int32_t x_end = std::min(x + width, WIDTH);
+        const int32_t y_end = std::min(y + height, HEIGHT);
+        for(int32_t row = std::max(y, 0); row < y_end; row++) {
+            for(int32_t col = std::max(x, 0); col < x_end; col++) {
+                draw_pixel(col, row);
+            }
+        }
+    }
+
+    void draw_glyph(int32_t x, int32_t y, uint16_t ch) {
+        // Glyphs are drawn transparently, like with the device fonts
+        const uint8_t* glyph = Font5x7::glyph(ch);
+        const int32_t top = y - Font5x7::ASCENT;
+        for(int32_t col = 0; col < Font5x7::GLYPH_WIDTH; col++) {
+            for(int32_t row = 0; row < Font5x7::GLYPH_HEIGHT; row++) {
+                if(glyph[col] & (1 << row)) {
+                    draw_pixel(x + col, top + row);
+                }
+            }
+        }
+    }
+
+    void draw_str(int32_t x, int32_t y, const char* str) {
+        for(; *str != '\0'; str++) {
+            draw_glyph(x, y, static_cast<uint8_t>(*str));
+            x += Font5x7::ADVANCE;
+        }
+    }
+
+    void draw_xbm(int32_t x, int32_t y, int32_t width, int32_t height, const uint8_t* bitmap) {
+        // In solid mode, clear bits are drawn in the opposite color, and XOR draws them white
+        const Color background = m_color == ColorWhite ? ColorBlack : ColorWhite;
+        const int32_t stride = (width + 7) / 8;
+        for(int32_t row = 0; row < height; row++) {
+            for(int32_t col = 0; col < width; col++) {
+                if(bitmap[row * stride + col / 8] & (1 << (col % 8))) {
+                    draw_pixel(x + col, y + row);
+                } else if(!m_bitmap_alpha) {
+                    draw_pixel(x + col, y + row, background);
+                }
+            }
+        }
+    }
+
+    // Midpoint circle, with only the selected quarters drawn
+    enum Quarter : uint8_t {
+        UpperRight = 1 << 0,
+        UpperLeft = 1 << 1,
+        LowerLeft = 1 << 2,
+        LowerRight = 1 << 3,
+    };
+
+    void draw_circle_quarters(
+        int32_t x0,
+        int32_t y0,
+        int32_t radius,
+        uint8_t quarters,
+        bool fill) {
+        auto plot = [&](int32_t dx, int32_t dy) {
+            auto span = [&](int32_t x, int32_t y, int32_t sign_y) {
+                if(fill) {
+                    for(int32_t i = 0; i <= dy; i++) {
+                        draw_pixel(x, y0 + sign_y * i);
+                    }
+                } else {
+                    draw_pixel(x, y);
+                }
+            };
+            if(quarters & UpperRight) {
+                span(x0 + dx, y0 - dy, -1);
+            }
+            if(quarters & UpperLeft) {
+                span(x0 - dx, y0 - dy, -1);
+            }
+            if(quarters & LowerLeft) {
+                span(x0 - dx, y0 + dy, 1);
+            }
+            if(quarters & LowerRight) {
+                span(x0 + dx, y0 + dy, 1);
+            }
+        };
+
+        int32_t f = 1 - radius;
+        int32_t dd_x = 1;
+        int32_t dd_y = -2 * radius;
+        int32_t x = 0;
+        int32_t y = radius;
+        plot(x, y);
+        plot(y, x);
+        while(x < y) {
+            if(f >= 0) {
+                y--;
+                dd_y += 2;
+                f += dd_y;
+            }
+            x++;
+            dd_x += 2;
+            f += dd_x;
+            plot(x, y);
+            plot(y, x);
+        }
+    }
+
+    static int32_t clamp_radius(int32_t width, int32_t height, int32_t radius) {
+        return std::min(radius, (std::min(width, height) - 1) / 2);
+    }
+};
+
+extern "C" {
+
+void canvas_reset(Canvas* canvas) {
+    furi_check(canvas);
+    std::memset(canvas->m_buffer, 0, sizeof(canvas->m_buffer));
+    canvas->m_color = ColorBlack;
+    canvas->m_font = FontSecondary;
+}
+
+void canvas_commit(Canvas* canvas) {
+    furi_check(canvas);
+    canvas->m_statistics.commits++;
+}
+
+size_t canvas_width(const Canvas* canvas) {
+    furi_check(canvas);
+    return Canvas::WIDTH;
+}
+
+size_t canvas_height(const Canvas* canvas) {
+    furi_check(canvas);
+    return Canvas::HEIGHT;
+}
+
+size_t canvas_current_font_height(const Canvas* canvas) {
+    furi_check(canvas);
+    return Font5x7::LINE_HEIGHT;
+}
+
+void canvas_clear(Canvas* canvas) {
+    furi_check(canvas);
+    canvas->m_statistics.draw_calls++;
+    std::memset(canvas->m_buffer, 0, sizeof(canvas->m_buffer));
+}
+
+void canvas_set_color(Canvas* canvas, Color color) {
+    furi_check(canvas);
+    canvas->m_color = color;
+}
+
+void canvas_invert_color(Canvas* canvas) {
+    furi_check(canvas);
+    if(canvas->m_color != ColorXOR) {
+        canvas->m_color = canvas->m_color == ColorBlack ? ColorWhite : ColorBlack;
+    }
+}
+
+void canvas_set_font(Canvas* canvas, Font font) {
+    furi_check(canvas && font < FontTotalNumber);
+    canvas->m_font = font;
+}
+
+void canvas_draw_str(Canvas* canvas, int32_t x, int32_t y, const char* str) {
+    furi_check(canvas);
+    canvas->m_statistics.draw_calls++;
+    if(str) {
+        canvas->draw_str(x, y, str);
+    }
+}
+
+void canvas_draw_str_aligned(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    Align horizontal,
+    Align vertical,
+    const char* str) {
+    furi_check(canvas);
+    canvas->m_statistics.draw_calls++;
+    if(!str) {
+        return;
+    }
+
+    switch(horizontal) {
+    case AlignRight:
+        x -= canvas_string_width(canvas, str);
+        break;
+    case AlignCenter:
+        x -= canvas_string_width(canvas, str) / 2;
+        break;
+    default:
+        break;
+    }
+
+    switch(vertical) {
+    case AlignTop:
+        y += Font5x7::ASCENT;
+        break;
+    case AlignCenter:
+        y += Font5x7::ASCENT / 2;
+        break;
+    default:
+        break;
+    }
+
+    canvas->draw_str(x, y, str);
+}
+
+uint16_t canvas_string_width(Canvas* canvas, const char* str) {
+    furi_check(canvas);
+    const size_t length = str ? std::strlen(str) : 0;
+    // The spacing after the last glyph doesn't count
+    return length > 0 ? length * Font5x7::ADVANCE - 1 : 0;
+}
+
+size_t canvas_glyph_width(Canvas* canvas, uint16_t symbol) {
+    furi_check(canvas);
+    UNUSED(symbol);
+    return Font5x7::ADVANCE;
+}
+
+void canvas_draw_glyph(Canvas* canvas, int32_t x, int32_t y, uint16_t ch) {
+    furi_check(canvas);
+    canvas->m_statistics.draw_calls++;
+    canvas->draw_glyph(x, y, ch);
+}
+
+void canvas_set_bitmap_mode(Canvas* canvas, bool alpha) {
+    furi_check(canvas);
+    canvas->m_bitmap_alpha = alpha;
+}
+
+void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon) {
+    furi_check(canvas && icon);
+    canvas->m_statistics.draw_calls++;
+
+    const uint8_t* frame = icon->frames[0];
+    if(frame[0] != 0x00) {
+        furi_crash("Compressed icons are not supported on the host");
+    }
+    canvas->draw_xbm(x, y, icon->width, icon->height, frame + 1);
+}
+
+void canvas_draw_xbm(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap) {
+    furi_check(canvas && bitmap);
+    canvas->m_statistics.draw_calls++;
+    canvas->draw_xbm(x, y, width, height, bitmap);
+}
+
+void canvas_draw_dot(Canvas* canvas, int32_t x, int32_t y) {
+    furi_check(canvas);
+    canvas->m_statistics.draw_calls++;
+    canvas->draw_pixel(x, y);
+}
+
+void canvas_draw_box(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    furi_check(canvas);
+    canvas->m_statistics.draw_calls++;
+    canvas->fill(x, y, width, height);
+}
+
+void canvas_draw_frame(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    furi_check(canvas);
+    canvas->m_statistics.draw_calls++;
+    if(width == 0 || height == 0) {
+        return;
+    }
+
+    const int32_t w = width;
+    const int32_t h = height;
+    canvas->fill(x, y, w, 1);
+    if(h > 1) {
+        canvas->fill(x, y + h - 1, w, 1);
+    }
+    if(h > 2) {
+        canvas->fill(x, y + 1, 1, h - 2);
+        if(w > 1) {
+            canvas->fill(x + w - 1, y + 1, 1, h - 2);
+        }
+    }
+}
+
+void canvas_draw_line(Canvas* canvas, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    furi_check(canvas);
+    canvas->m_statistics.draw_calls++;
+
+    // Bresenham, both ends included
+    const int32_t dx = std::abs(x2 - x1);
+    const int32_t dy = -std::abs(y2 - y1);
+    const int32_t step_x = x1 < x2 ? 1 : -1;
+    const int32_t step_y = y1 < y2 ? 1 : -1;
+    int32_t error = dx + dy;
+    for(;;) {
+        canvas->draw_pixel(x1, y1);
+        if(x1 == x2 && y1 == y2) {
+            break;
+        }
+        const int32_t error2 = error * 2;
+        if(error2 >= dy) {
+            error += dy;
+            x1 += step_x;
+        }
+        if(error2 <= dx) {
+            error += dx;
+            y1 += step_y;
+        }
+    }
+}
+
+void canvas_draw_rframe(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    size_t radius) {
+    furi_check(canvas);
+    canvas->m_statistics.draw_calls++;
+    if(width == 0 || height == 0) {
+        return;
+    }
+
+    const int32_t w = width;
+    const int32_t h = height;
+    const int32_t r = Canvas::clamp_radius(w, h, radius);
+    const int32_t left = x + r;
+    const int32_t right = x + w - 1 - r;
+    const int32_t top = y + r;
+    const int32_t bottom = y + h - 1 - r;
+
+    canvas->draw_circle_quarters(left, top, r, Canvas::UpperLeft, false);
+    canvas->draw_circle_quarters(right, top, r, Canvas::UpperRight, false);
+    canvas->draw_circle_quarters(left, bottom, r, Canvas::LowerLeft, false);
+    canvas->draw_circle_quarters(right, bottom, r, Canvas::LowerRight, false);
+
+    canvas->fill(left + 1, y, right - left - 1, 1);
+    canvas->fill(left + 1, y + h - 1, right - left - 1, 1);
+    canvas->fill(x, top + 1, 1, bottom - top - 1);
+    canvas->fill(x + w - 1, top + 1, 1, bottom - top - 1);
+}
+
+void canvas_draw_rbox(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    size_t radius) {
+    furi_check(canvas);
+    canvas->m_statistics.draw_calls++;
+    if(width == 0 || height == 0) {
+        return;
+    }
+
+    const int32_t w = width;
+    const int32_t h = height;
+    const int32_t r = Canvas::clamp_radius(w, h, radius);
+    const int32_t left = x + r;
+    const int32_t right = x + w - 1 - r;
+    const int32_t top = y + r;
+    const int32_t bottom = y + h - 1 - r;
+
+    canvas->draw_circle_quarters(left, top, r, Canvas::UpperLeft, true);
+    canvas->draw_circle_quarters(right, top, r, Canvas::UpperRight, true);
+    canvas->draw_circle_quarters(left, bottom, r, Canvas::LowerLeft, true);
+    canvas->draw_circle_quarters(right, bottom, r, Canvas::LowerRight, true);
+
+    // Columns between the corners, then the sides between them
+    canvas->fill(left + 1, y, right - left - 1, h);
+    canvas->fill(x, top + 1, r + 1, bottom - top - 1);
+    canvas->fill(right, top + 1, r + 1, bottom - top - 1);
+}
+
+Canvas* canvas_host_alloc(void) {
+    return new Canvas;
+}
+
+void canvas_host_free(Canvas* canvas) {
+    furi_check(canvas);
+    delete canvas;
+}
+
+bool canvas_host_get_pixel(const Canvas* canvas, int32_t x, int32_t y) {
+    furi_check(canvas);
+    if(x < 0 || y < 0 || x >= Canvas::WIDTH || y >= Canvas::HEIGHT) {
+        return false;
+    }
+    return canvas->m_buffer[y * Canvas::STRIDE + x / 8] & (0x80 >> (x % 8));
+}
+
+const uint8_t* canvas_host_get_buffer(const Canvas* canvas) {
+    furi_check(canvas);
+    return canvas->m_buffer;
+}
+
+size_t canvas_host_get_buffer_size(const Canvas* canvas) {
+    furi_check(canvas);
+    return sizeof(canvas->m_buffer);
+}
+
+CanvasHostStatistics canvas_host_get_statistics(const Canvas* canvas) {
+    furi_check(canvas);
+    return canvas->m_statistics;
+}
+
+void canvas_host_reset_statistics(Canvas* canvas) {
+    furi_check(canvas);
+    canvas->m_statistics = {};
+}
+
+bool canvas_host_save_pbm(const Canvas* canvas, const char* path) {
+    furi_check(canvas && path);
+    FILE* file = std::fopen(path, "wb");
+    if(!file) {
+        return false;
+    }
+
+    std::fprintf(file, "P4\n%ld %ld\n", long(Canvas::WIDTH), long(Canvas::HEIGHT));
+    const bool written =
+        std::fwrite(canvas->m_buffer, sizeof(canvas->m_buffer), 1, file) == 1;
+    return std::fclose(file) == 0 && written;
+}
+
+// Reads a number from the PBM header, skipping whitespace and comments
+static bool pbm_read_number(FILE* file, long& number) {
+    int ch;
+    for(;;) {
+        ch = std::fgetc(file);
+        if(ch == '#') {
+            while(ch != EOF && ch != '\n') {
+                ch = std::fgetc(file);
+            }
+        } else if(!std::isspace(ch)) {
+            break;
+        }
+    }
+
+    if(!std::isdigit(ch)) {
+        return false;
+    }
+    number = 0;
+    while(std::isdigit(ch)) {
+        number = number * 10 + (ch - '0');
+        ch = std::fgetc(file);
+    }
+    // A single whitespace character separates the header from the raster
+    return std::isspace(ch);
+}
+
+int32_t canvas_host_compare_pbm(const Canvas* canvas, const char* path) {
+    furi_check(canvas && path);
+    FILE* file = std::fopen(path, "rb");
+    if(!file) {
+        return -1;
+    }
+
+    uint8_t raster[sizeof(canvas->m_buffer)];
+    long width, height;
+    const bool valid = std::fgetc(file) == 'P' && std::fgetc(file) == '4' &&
+                       pbm_read_number(file, width) && pbm_read_number(file, height) &&
+                       width == Canvas::WIDTH && height == Canvas::HEIGHT &&
+                       std::fread(raster, sizeof(raster), 1, file) == 1;
+    std::fclose(file);
+    if(!valid) {
+        return -1;
+    }
+
+    int32_t mismatches = 0;
+    for(size_t i = 0; i < sizeof(raster); i++) {
+        mismatches += __builtin_popcount(raster[i] ^ canvas->m_buffer[i]);
+    }
+    return mismatches;
+}
+}
@@ -0,0 +1,59 @@
+#include <furi/core/check.h>
+#include <gui/elements.h>
+
+#include <cstring>
+#include <string>
+
+extern "C" {
+
+void elements_bold_rounded_frame(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height) {
+    furi_check(canvas);
+    const int32_t w = width;
+    const int32_t h = height;
+
+    canvas_set_color(canvas, ColorWhite);
+    canvas_draw_box(canvas, x + 2, y + 2, w - 3, h - 3);
+    canvas_set_color(canvas, ColorBlack);
+
+    canvas_draw_line(canvas, x + 3, y, x + w - 3, y);
+    canvas_draw_line(canvas, x + 2, y + 1, x + w - 2, y + 1);
+
+    canvas_draw_line(canvas, x, y + 3, x, y + h - 3);
+    canvas_draw_line(canvas, x + 1, y + 2, x + 1, y + h - 2);
+
+    canvas_draw_line(canvas, x + w, y + 3, x + w, y + h - 3);
+    canvas_draw_line(canvas, x + w - 1, y + 2, x + w - 1, y + h - 2);
+
+    canvas_draw_line(canvas, x + 3, y + h, x + w - 3, y + h);
+    canvas_draw_line(canvas, x + 2, y + h - 1, x + w - 2, y + h - 1);
+
+    canvas_draw_dot(canvas, x + 2, y + 2);
+    canvas_draw_dot(canvas, x + w - 2, y + 2);
+    canvas_draw_dot(canvas, x + 2, y + h - 2);
+    canvas_draw_dot(canvas, x + w - 2, y + h - 2);
+}
+
+void elements_multiline_text(Canvas* canvas, int32_t x, int32_t y, const char* text) {
+    furi_check(canvas && text);
+    const int32_t font_height = canvas_current_font_height(canvas);
+
+    std::string line;
+    const char* end;
+    do {
+        end = std::strchr(text, '\n');
+        if(end) {
+            line.assign(text, end);
+            text = end + 1;
+        } else {
+            line.assign(text);
+        }
+        canvas_draw_str(canvas, x, y, line.c_str());
+        y += font_height;
+    } while(end && y < static_cast<int32_t>(canvas_height(canvas)));
+}
+}
@@ -0,0 +1,338 @@
+#include "kernel.hpp"
+
+#include <furi/core/check.h>
+#include <furi/core/common_defines.h>
+#include <furi/core/event_loop.h>
+#include <furi/core/event_loop_timer.h>
+#include <furi/core/thread.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+
+using namespace cookie::host;
+
+struct FuriEventLoopTimer {
+    FuriEventLoopTimer(
+        FuriEventLoop* loop,
+        FuriEventLoopTimerCallback callback,
+        FuriEventLoopTimerType type,
+        void* context)
+        : m_loop(loop)
+        , m_callback(callback)
+        , m_context(context)
+        , m_type(type) {
+    }
+
+    FuriEventLoop* m_loop;
+    FuriEventLoopTimerCallback m_callback;
+    void* m_context;
+    FuriEventLoopTimerType m_type;
+    uint32_t m_interval = 0;
+    uint64_t m_expiry = 0;
+    Kernel::Deadline m_deadline;
+    bool m_running = false;
+};
+
+struct FuriEventLoop {
+    struct PendingCallback {
+        FuriEventLoopPendingCallback callback;
+        void* context;
+    };
+
+    FuriThreadId m_thread_id = furi_thread_get_current_id();
+    bool m_stop_requested = false;
+    std::deque<PendingCallback> m_pending;
+    std::vector<std::unique_ptr<Subscription>> m_subscriptions;
+    std::vector<FuriEventLoopTimer*> m_timers;
+    // Where to start looking for ready subscriptions next, so none of them starves the others
+    size_t m_next_subscription = 0;
+};
+
+namespace {
+
+void check_thread(const FuriEventLoop* instance) {
+    furi_check(instance->m_thread_id == furi_thread_get_current_id());
+}
+
+void stop_timer_locked(Kernel& kernel, FuriEventLoopTimer* timer) {
+    if(timer->m_running) {
+        timer->m_running = false;
+        kernel.remove_deadline(timer->m_deadline);
+    }
+}
+
+void start_timer_locked(Kernel& kernel, FuriEventLoopTimer* timer, uint64_t expiry) {
+    timer->m_expiry = expiry;
+    timer->m_deadline = kernel.add_deadline(expiry);
+    timer->m_running = true;
+}
+
+bool is_ready(const Subscription& subscription) {
+    if(subscription.event & FuriEventLoopEventFlagEdge) {
+        return subscription.signaled;
+    }
+    return subscription.target->is_ready(
+        static_cast<FuriEventLoopEvent>(subscription.event & FuriEventLoopEventMask));
+}
+
+void unsubscribe_locked(FuriEventLoop* instance, Subscription* subscription) {
+    subscription->target->m_subscription = nullptr;
+    auto it = std::find_if(
+        instance->m_subscriptions.begin(),
+        instance->m_subscriptions.end(),
+        [subscription](const auto& s) { return s.get() == subscription; });
+    instance->m_subscriptions.erase(it);
+}
+
+void subscribe(
+    FuriEventLoop* instance,
+    FuriEventLoopObject* object,
+    EventObject* target,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_check(instance && object && callback);
+    check_thread(instance);
+
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    furi_check(target->m_subscription == nullptr);
+
+    auto subscription = std::make_unique<Subscription>(
+        Subscription{object, target, event, callback, context, false});
+    target->m_subscription = subscription.get();
+    instance->m_subscriptions.push_back(std::move(subscription));
+    kernel.notify();
+}
+
+}
+
+extern "C" {
+
+FuriEventLoop* furi_event_loop_alloc(void) {
+    return new FuriEventLoop;
+}
+
+void furi_event_loop_free(FuriEventLoop* instance) {
+    furi_check(instance);
+    check_thread(instance);
+    furi_check(instance->m_subscriptions.empty());
+    furi_check(instance->m_timers.empty());
+    delete instance;
+}
+
+void furi_event_loop_run(FuriEventLoop* instance) {
+    furi_check(instance);
+    check_thread(instance);
+
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    // Furi threads are agents already
+    Agent agent;
+    const bool own_agent = Kernel::get_current_agent() == nullptr;
+    if(own_agent) {
+        kernel.add_agent(agent);
+        Kernel::set_current_agent(&agent);
+    }
+
+    // Pending callbacks go first, then timers, then subscriptions, one callback at a time,
+    // re-checking everything in between as the callbacks may change any of it
+    while(!instance->m_stop_requested) {
+        if(!instance->m_pending.empty()) {
+            const FuriEventLoop::PendingCallback pending = instance->m_pending.front();
+            instance->m_pending.pop_front();
+            lock.unlock();
+            pending.callback(pending.context);
+            lock.lock();
+            continue;
+        }
+
+        FuriEventLoopTimer* expired = nullptr;
+        for(FuriEventLoopTimer* timer : instance->m_timers) {
+            if(timer->m_running && timer->m_expiry <= kernel.now() &&
+               (!expired || timer->m_expiry < expired->m_expiry)) {
+                expired = timer;
+            }
+        }
+        if(expired) {
+            stop_timer_locked(kernel, expired);
+            if(expired->m_type == FuriEventLoopTimerTypePeriodic) {
+                start_timer_locked(kernel, expired, expired->m_expiry + expired->m_interval);
+            }
+            lock.unlock();
+            expired->m_callback(expired->m_context);
+            lock.lock();
+            continue;
+        }
+
+        Subscription* ready = nullptr;
+        const size_t count = instance->m_subscriptions.size();
+        for(size_t i = 0; i < count; i++) {
+            Subscription* subscription =
+                instance->m_subscriptions[(instance->m_next_subscription + i) % count].get();
+            if(is_ready(*subscription)) {
+                ready = subscription;
+                instance->m_next_subscription = (instance->m_next_subscription + i + 1) % count;
+                break;
+            }
+        }
+        if(ready) {
+            const Subscription subscription = *ready;
+            ready->signaled = false;
+            if(ready->event & FuriEventLoopEventFlagOnce) {
+                unsubscribe_locked(instance, ready);
+            }
+            lock.unlock();
+            subscription.callback(subscription.object, subscription.context);
+            lock.lock();
+            continue;
+        }
+
+        kernel.wait(lock);
+    }
+
+    instance->m_stop_requested = false;
+    if(own_agent) {
+        Kernel::set_current_agent(nullptr);
+        kernel.remove_agent(agent);
+    }
+}
+
+void furi_event_loop_stop(FuriEventLoop* instance) {
+    furi_check(instance);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    instance->m_stop_requested = true;
+    kernel.notify();
+}
+
+void furi_event_loop_pend_callback(
+    FuriEventLoop* instance,
+    FuriEventLoopPendingCallback callback,
+    void* context) {
+    furi_check(instance && callback);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    instance->m_pending.push_back({callback, context});
+    kernel.notify();
+}
+
+void furi_event_loop_subscribe_semaphore(
+    FuriEventLoop* instance,
+    FuriSemaphore* semaphore,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_check(semaphore);
+    subscribe(instance, semaphore, &event_object(semaphore), event, callback, context);
+}
+
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* message_queue,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_check(message_queue);
+    subscribe(instance, message_queue, &event_object(message_queue), event, callback, context);
+}
+
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, FuriEventLoopObject* object) {
+    furi_check(instance && object);
+    check_thread(instance);
+
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    auto it = std::find_if(
+        instance->m_subscriptions.begin(),
+        instance->m_subscriptions.end(),
+        [object](const auto& s) { return s->object == object; });
+    furi_check(it != instance->m_subscriptions.end());
+    unsubscribe_locked(instance, it->get());
+}
+
+bool furi_event_loop_is_subscribed(FuriEventLoop* instance, FuriEventLoopObject* object) {
+    furi_check(instance && object);
+    auto lock = Kernel::get().lock();
+    return std::any_of(
+        instance->m_subscriptions.begin(),
+        instance->m_subscriptions.end(),
+        [object](const auto& s) { return s->object == object; });
+}
+
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context) {
+    furi_check(instance && callback);
+    check_thread(instance);
+
+    auto lock = Kernel::get().lock();
+    FuriEventLoopTimer* timer = new FuriEventLoopTimer(instance, callback, type, context);
+    instance->m_timers.push_back(timer);
+    return timer;
+}
+
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    check_thread(timer->m_loop);
+
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    stop_timer_locked(kernel, timer);
+    auto& timers = timer->m_loop->m_timers;
+    timers.erase(std::find(timers.begin(), timers.end(), timer));
+    delete timer;
+}
+
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval) {
+    furi_check(timer);
+    furi_check(interval > 0 && interval < (1U << 31));
+    check_thread(timer->m_loop);
+
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    stop_timer_locked(kernel, timer);
+    timer->m_interval = interval;
+    start_timer_locked(kernel, timer, kernel.now() + interval);
+    kernel.notify();
+}
+
+void furi_event_loop_timer_restart(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    furi_event_loop_timer_start(timer, timer->m_interval);
+}
+
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    check_thread(timer->m_loop);
+
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    stop_timer_locked(kernel, timer);
+}
+
+uint32_t furi_event_loop_timer_get_remaining_time(const FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    if(!timer->m_running || timer->m_expiry <= kernel.now()) {
+        return 0;
+    }
+    return static_cast<uint32_t>(timer->m_expiry - kernel.now());
+}
+
+uint32_t furi_event_loop_timer_get_interval(const FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    return timer->m_interval;
+}
+
+bool furi_event_loop_timer_is_running(const FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    auto lock = Kernel::get().lock();
+    return timer->m_running;
+}
+}
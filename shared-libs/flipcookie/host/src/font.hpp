@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace cookie::host {
+
+// Classic 5x7 font covering printable ASCII. Every glyph is 5 columns, left to right,
+// with the top row in the least significant bit of each column.
+struct Font5x7 {
+    static constexpr char FIRST = ' ';
+    static constexpr char LAST = '~';
+    static constexpr int32_t GLYPH_WIDTH = 5;
+    static constexpr int32_t GLYPH_HEIGHT = 7;
+    static constexpr int32_t ADVANCE = GLYPH_WIDTH + 1;
+    static constexpr int32_t ASCENT = GLYPH_HEIGHT;
+    static constexpr int32_t LINE_HEIGHT = GLYPH_HEIGHT + 1;
+
+    // Characters outside the font are drawn as '?'
+    static const uint8_t* glyph(uint16_t ch);
+};
+
+}
@@ -0,0 +1,15 @@
+#include <furi/core/check.h>
+#include <gui/icon.h>
+
+extern "C" {
+
+uint16_t icon_get_width(const Icon* instance) {
+    furi_check(instance);
+    return instance->width;
+}
+
+uint16_t icon_get_height(const Icon* instance) {
+    furi_check(instance);
+    return instance->height;
+}
+}
@@ -0,0 +1,17 @@
+#include <furi/core/check.h>
+#include <input/input.h>
+
+extern "C" {
+
+const char* input_get_key_name(InputKey key) {
+    static const char* const names[] = {"Up", "Down", "Right", "Left", "Ok", "Back"};
+    furi_check(key < InputKeyMAX);
+    return names[key];
+}
+
+const char* input_get_type_name(InputType type) {
+    static const char* const names[] = {"Press", "Release", "Short", "Long", "Repeat"};
+    furi_check(type < InputTypeMAX);
+    return names[type];
+}
+}
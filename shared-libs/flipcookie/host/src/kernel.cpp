@@ -0,0 +1,187 @@
+#include "kernel.hpp"
+
+#include <furi/core/check.h>
+#include <furi/core/common_defines.h>
+#include <furi/core/kernel.h>
+#include <furi_host.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace cookie::host {
+
+namespace {
+thread_local Agent* t_current_agent = nullptr;
+}
+
+Kernel& Kernel::get() {
+    // Never destroyed, so timers and threads may outlive static destructors
+    static Kernel* kernel = new Kernel;
+    return *kernel;
+}
+
+void Kernel::notify() {
+    for(Agent* agent : m_agents) {
+        agent->idle = false;
+    }
+    m_idle_agents = 0;
+    m_changed.notify_all();
+}
+
+void Kernel::wait(std::unique_lock<std::mutex>& lock, bool can_skip_ahead) {
+    Agent* agent = t_current_agent;
+    if(agent && !agent->idle) {
+        agent->idle = true;
+        m_idle_agents++;
+    }
+
+    if(all_agents_idle()) {
+        if(m_auto_advance && (can_skip_ahead || m_waiting_skippers > 0) && skip_ahead()) {
+            return;
+        }
+        m_agents_idle.notify_all();
+    }
+
+    if(can_skip_ahead) {
+        m_waiting_skippers++;
+    }
+    m_changed.wait(lock);
+    if(can_skip_ahead) {
+        m_waiting_skippers--;
+    }
+}
+
+bool Kernel::skip_ahead() {
+    if(m_deadlines.empty() || *m_deadlines.begin() <= m_now) {
+        return false;
+    }
+    m_now = *m_deadlines.begin();
+    notify();
+    return true;
+}
+
+void Kernel::add_agent(Agent& agent) {
+    agent.idle = false;
+    m_agents.push_back(&agent);
+}
+
+void Kernel::remove_agent(Agent& agent) {
+    if(agent.idle) {
+        m_idle_agents--;
+    }
+    m_agents.erase(std::find(m_agents.begin(), m_agents.end(), &agent));
+    // The remaining agents may all be idle now
+    notify();
+}
+
+void Kernel::advance(std::unique_lock<std::mutex>& lock, uint64_t ticks) {
+    // Step from deadline to deadline, letting the agents handle each one before moving on
+    const uint64_t target = m_now + ticks;
+    while(m_now < target) {
+        const auto next = m_deadlines.upper_bound(m_now);
+        m_now = next != m_deadlines.end() && *next < target ? *next : target;
+        notify();
+        m_agents_idle.wait(lock, [this] { return all_agents_idle(); });
+    }
+}
+
+void Kernel::set_current_agent(Agent* agent) {
+    furi_check(agent == nullptr || t_current_agent == nullptr);
+    t_current_agent = agent;
+}
+
+Agent* Kernel::get_current_agent() {
+    return t_current_agent;
+}
+
+void signal(EventObject& object, FuriEventLoopEvent event) {
+    Subscription* subscription = object.m_subscription;
+    if(subscription && (subscription->event & FuriEventLoopEventMask) == event) {
+        subscription->signaled = true;
+    }
+}
+
+}
+
+using namespace cookie::host;
+
+namespace {
+std::recursive_mutex& critical_mutex() {
+    static std::recursive_mutex* mutex = new std::recursive_mutex;
+    return *mutex;
+}
+}
+
+extern "C" {
+
+void __furi_host_crash(const char* message, const char* expression, const char* file, int line) {
+    std::fprintf(
+        stderr,
+        "furi_crash: %s (%s) at %s:%d\n",
+        message,
+        expression ? expression : "-",
+        file,
+        line);
+    std::abort();
+}
+
+__FuriCriticalInfo __furi_critical_enter(void) {
+    critical_mutex().lock();
+    return {0, false, true};
+}
+
+void __furi_critical_exit(__FuriCriticalInfo info) {
+    UNUSED(info);
+    critical_mutex().unlock();
+}
+
+bool furi_kernel_is_irq_or_masked(void) {
+    return false;
+}
+
+bool furi_kernel_is_running(void) {
+    return true;
+}
+
+uint32_t furi_get_tick(void) {
+    return static_cast<uint32_t>(furi_host_get_tick64());
+}
+
+uint32_t furi_kernel_get_tick_frequency(void) {
+    return 1000;
+}
+
+uint32_t furi_ms_to_ticks(uint32_t milliseconds) {
+    return milliseconds;
+}
+
+void furi_delay_tick(uint32_t ticks) {
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    kernel.wait_for(lock, ticks, [] { return false; });
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    furi_delay_tick(furi_ms_to_ticks(milliseconds));
+}
+
+void furi_host_set_auto_advance(bool enable) {
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    kernel.set_auto_advance(enable);
+    kernel.notify();
+}
+
+void furi_host_advance_ticks(uint32_t ticks) {
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    kernel.advance(lock, ticks);
+}
+
+uint64_t furi_host_get_tick64(void) {
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    return kernel.now();
+}
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <furi/core/event_loop.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace cookie::host {
+
+struct Subscription;
+
+// Anything an event loop can subscribe to
+class EventObject {
+public:
+    virtual ~EventObject() = default;
+
+    // Level of the object, for level-triggered subscriptions
+    virtual bool is_ready(FuriEventLoopEvent event) const = 0;
+
+    Subscription* m_subscription = nullptr;
+};
+
+struct Subscription {
+    FuriEventLoopObject* object;
+    EventObject* target;
+    FuriEventLoopEvent event;
+    FuriEventLoopEventCallback callback;
+    void* context;
+    // Set on a state change, for edge-triggered subscriptions
+    bool signaled;
+};
+
+EventObject& event_object(FuriSemaphore* semaphore);
+EventObject& event_object(FuriMessageQueue* message_queue);
+
+// Marks the object's subscription as signaled if it's interested in this direction.
+// Must be called with the kernel locked.
+void signal(EventObject& object, FuriEventLoopEvent event);
+
+// Threads the virtual time waits for: event loops while they run, Furi threads and the timer
+// thread. An agent is idle when it's waiting for something to happen, and stops being idle
+// on every change of state, until it checks for work again.
+struct Agent {
+    bool idle = false;
+};
+
+// State shared by all host objects. Everything is guarded by a single lock, and every change
+// of state wakes up all the waiting threads - the emulation favours simplicity over speed.
+class Kernel {
+public:
+    using Deadline = std::multiset<uint64_t>::iterator;
+
+    static Kernel& get();
+
+    std::unique_lock<std::mutex> lock() {
+        return std::unique_lock<std::mutex>(m_mutex);
+    }
+
+    // All of the below must be called with the lock held
+
+    uint64_t now() const {
+        return m_now;
+    }
+
+    // Wakes up all the waiting threads, they have to check for work again
+    void notify();
+
+    // Waits for a change of state. If this was the last busy agent, skips the time ahead
+    // to the nearest deadline instead, and returns immediately. The timer thread waits
+    // with can_skip_ahead unset, so it only moves the time when another thread is waiting.
+    void wait(std::unique_lock<std::mutex>& lock, bool can_skip_ahead = true);
+
+    // Waits until ready() returns true, or the timeout (in ticks) passes
+    template <typename Pred>
+    bool wait_for(std::unique_lock<std::mutex>& lock, uint32_t timeout, Pred ready);
+
+    Deadline add_deadline(uint64_t tick) {
+        return m_deadlines.insert(tick);
+    }
+
+    void remove_deadline(Deadline deadline) {
+        m_deadlines.erase(deadline);
+    }
+
+    // Agents are added by the thread starting them, and removed by their own thread
+    void add_agent(Agent& agent);
+    void remove_agent(Agent& agent);
+
+    // Marks the calling thread as the agent, needed to track it while it waits
+    static void set_current_agent(Agent* agent);
+    static Agent* get_current_agent();
+
+    void set_auto_advance(bool enable) {
+        m_auto_advance = enable;
+    }
+
+    void advance(std::unique_lock<std::mutex>& lock, uint64_t ticks);
+
+private:
+    bool all_agents_idle() const {
+        return m_idle_agents == m_agents.size();
+    }
+
+    bool skip_ahead();
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::condition_variable m_agents_idle;
+
+    uint64_t m_now = 0;
+    std::multiset<uint64_t> m_deadlines;
+    std::vector<Agent*> m_agents;
+    size_t m_idle_agents = 0;
+    // Threads waiting that would skip the time ahead if they were the last agent to go idle
+    size_t m_waiting_skippers = 0;
+    bool m_auto_advance = true;
+};
+
+template <typename Pred>
+bool Kernel::wait_for(std::unique_lock<std::mutex>& lock, uint32_t timeout, Pred ready) {
+    if(ready()) {
+        return true;
+    }
+    if(timeout == 0) {
+        return false;
+    }
+
+    if(timeout == FuriWaitForever) {
+        while(!ready()) {
+            wait(lock);
+        }
+        return true;
+    }
+
+    const uint64_t tick = m_now + timeout;
+    const Deadline deadline = add_deadline(tick);
+    bool result = true;
+    while(!ready()) {
+        if(m_now >= tick) {
+            result = false;
+            break;
+        }
+        wait(lock);
+    }
+    remove_deadline(deadline);
+    return result;
+}
+
+}
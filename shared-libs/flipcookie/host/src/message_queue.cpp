@@ -0,0 +1,116 @@
+#include "kernel.hpp"
+
+#include <furi/core/check.h>
+#include <furi/core/message_queue.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace cookie::host;
+
+struct FuriMessageQueue : EventObject {
+    FuriMessageQueue(uint32_t msg_count, uint32_t msg_size)
+        : m_capacity(msg_count)
+        , m_message_size(msg_size)
+        , m_storage(size_t(msg_count) * msg_size) {
+    }
+
+    bool is_ready(FuriEventLoopEvent event) const override {
+        return event == FuriEventLoopEventIn ? m_count > 0 : m_count < m_capacity;
+    }
+
+    uint8_t* slot(uint32_t index) {
+        return &m_storage[size_t(index % m_capacity) * m_message_size];
+    }
+
+    const uint32_t m_capacity;
+    const uint32_t m_message_size;
+    std::vector<uint8_t> m_storage;
+    uint32_t m_first = 0;
+    uint32_t m_count = 0;
+};
+
+EventObject& cookie::host::event_object(FuriMessageQueue* message_queue) {
+    return *message_queue;
+}
+
+extern "C" {
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
+    furi_check(msg_count > 0 && msg_size > 0);
+    return new FuriMessageQueue(msg_count, msg_size);
+}
+
+void furi_message_queue_free(FuriMessageQueue* instance) {
+    furi_check(instance);
+    furi_check(instance->m_subscription == nullptr);
+    delete instance;
+}
+
+FuriStatus
+    furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout) {
+    furi_check(instance && msg_ptr);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    if(!kernel.wait_for(
+           lock, timeout, [instance] { return instance->m_count < instance->m_capacity; })) {
+        return timeout ? FuriStatusErrorTimeout : FuriStatusErrorResource;
+    }
+
+    std::memcpy(
+        instance->slot(instance->m_first + instance->m_count), msg_ptr, instance->m_message_size);
+    instance->m_count++;
+    signal(*instance, FuriEventLoopEventIn);
+    kernel.notify();
+    return FuriStatusOk;
+}
+
+FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout) {
+    furi_check(instance && msg_ptr);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    if(!kernel.wait_for(lock, timeout, [instance] { return instance->m_count > 0; })) {
+        return timeout ? FuriStatusErrorTimeout : FuriStatusErrorResource;
+    }
+
+    std::memcpy(msg_ptr, instance->slot(instance->m_first), instance->m_message_size);
+    instance->m_first = (instance->m_first + 1) % instance->m_capacity;
+    instance->m_count--;
+    signal(*instance, FuriEventLoopEventOut);
+    kernel.notify();
+    return FuriStatusOk;
+}
+
+uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
+    furi_check(instance);
+    return instance->m_capacity;
+}
+
+uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
+    furi_check(instance);
+    return instance->m_message_size;
+}
+
+uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
+    furi_check(instance);
+    auto lock = Kernel::get().lock();
+    return instance->m_count;
+}
+
+uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
+    furi_check(instance);
+    auto lock = Kernel::get().lock();
+    return instance->m_capacity - instance->m_count;
+}
+
+FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
+    furi_check(instance);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    instance->m_first = 0;
+    instance->m_count = 0;
+    signal(*instance, FuriEventLoopEventOut);
+    kernel.notify();
+    return FuriStatusOk;
+}
+}
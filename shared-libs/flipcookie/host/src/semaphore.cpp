@@ -0,0 +1,78 @@
+#include "kernel.hpp"
+
+#include <furi/core/check.h>
+#include <furi/core/semaphore.h>
+
+using namespace cookie::host;
+
+struct FuriSemaphore : EventObject {
+    FuriSemaphore(uint32_t max_count, uint32_t initial_count)
+        : m_max_count(max_count)
+        , m_count(initial_count) {
+    }
+
+    bool is_ready(FuriEventLoopEvent event) const override {
+        return event == FuriEventLoopEventIn ? m_count > 0 : m_count < m_max_count;
+    }
+
+    const uint32_t m_max_count;
+    uint32_t m_count;
+};
+
+EventObject& cookie::host::event_object(FuriSemaphore* semaphore) {
+    return *semaphore;
+}
+
+extern "C" {
+
+FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count) {
+    furi_check(max_count && initial_count <= max_count);
+    return new FuriSemaphore(max_count, initial_count);
+}
+
+void furi_semaphore_free(FuriSemaphore* instance) {
+    furi_check(instance);
+    furi_check(instance->m_subscription == nullptr);
+    delete instance;
+}
+
+FuriStatus furi_semaphore_acquire(FuriSemaphore* instance, uint32_t timeout) {
+    furi_check(instance);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    if(!kernel.wait_for(lock, timeout, [instance] { return instance->m_count > 0; })) {
+        return timeout ? FuriStatusErrorTimeout : FuriStatusErrorResource;
+    }
+
+    instance->m_count--;
+    signal(*instance, FuriEventLoopEventOut);
+    kernel.notify();
+    return FuriStatusOk;
+}
+
+FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
+    furi_check(instance);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    if(instance->m_count == instance->m_max_count) {
+        return FuriStatusErrorResource;
+    }
+
+    instance->m_count++;
+    signal(*instance, FuriEventLoopEventIn);
+    kernel.notify();
+    return FuriStatusOk;
+}
+
+uint32_t furi_semaphore_get_count(FuriSemaphore* instance) {
+    furi_check(instance);
+    auto lock = Kernel::get().lock();
+    return instance->m_count;
+}
+
+uint32_t furi_semaphore_get_space(FuriSemaphore* instance) {
+    furi_check(instance);
+    auto lock = Kernel::get().lock();
+    return instance->m_max_count - instance->m_count;
+}
+}
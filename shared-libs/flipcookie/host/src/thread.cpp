@@ -0,0 +1,131 @@
+#include "kernel.hpp"
+
+#include <furi/core/check.h>
+#include <furi/core/thread.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+using namespace cookie::host;
+
+struct FuriThread {
+    std::string m_name;
+    FuriThreadCallback m_callback = nullptr;
+    void* m_context = nullptr;
+    std::thread m_thread;
+    std::atomic<FuriThreadState> m_state{FuriThreadStateStopped};
+    // Keeps the virtual time from skipping ahead while the thread is busy
+    Agent m_agent;
+    int32_t m_return_code = 0;
+};
+
+extern "C" {
+
+FuriThread* furi_thread_alloc(void) {
+    return new FuriThread;
+}
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context) {
+    UNUSED(stack_size);
+    FuriThread* thread = furi_thread_alloc();
+    furi_thread_set_name(thread, name);
+    furi_thread_set_callback(thread, callback);
+    furi_thread_set_context(thread, context);
+    return thread;
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_check(thread);
+    furi_check(thread->m_state == FuriThreadStateStopped);
+    if(thread->m_thread.joinable()) {
+        thread->m_thread.join();
+    }
+    delete thread;
+}
+
+void furi_thread_set_name(FuriThread* thread, const char* name) {
+    furi_check(thread && thread->m_state == FuriThreadStateStopped);
+    thread->m_name = name ? name : "";
+}
+
+void furi_thread_set_stack_size(FuriThread* thread, size_t stack_size) {
+    furi_check(thread && thread->m_state == FuriThreadStateStopped);
+    UNUSED(stack_size);
+}
+
+void furi_thread_set_callback(FuriThread* thread, FuriThreadCallback callback) {
+    furi_check(thread && thread->m_state == FuriThreadStateStopped);
+    thread->m_callback = callback;
+}
+
+void furi_thread_set_context(FuriThread* thread, void* context) {
+    furi_check(thread && thread->m_state == FuriThreadStateStopped);
+    thread->m_context = context;
+}
+
+void furi_thread_set_priority(FuriThread* thread, FuriThreadPriority priority) {
+    furi_check(thread);
+    UNUSED(priority);
+}
+
+FuriThreadState furi_thread_get_state(FuriThread* thread) {
+    furi_check(thread);
+    return thread->m_state;
+}
+
+void furi_thread_start(FuriThread* thread) {
+    furi_check(thread && thread->m_callback);
+    furi_check(thread->m_state == FuriThreadStateStopped);
+    if(thread->m_thread.joinable()) {
+        thread->m_thread.join();
+    }
+
+    // The thread counts as busy from the start, so the time can't skip ahead before it runs
+    Kernel& kernel = Kernel::get();
+    {
+        auto lock = kernel.lock();
+        kernel.add_agent(thread->m_agent);
+    }
+
+    thread->m_state = FuriThreadStateStarting;
+    thread->m_thread = std::thread([thread, &kernel] {
+        Kernel::set_current_agent(&thread->m_agent);
+        thread->m_state = FuriThreadStateRunning;
+        thread->m_return_code = thread->m_callback(thread->m_context);
+
+        Kernel::set_current_agent(nullptr);
+        {
+            auto lock = kernel.lock();
+            kernel.remove_agent(thread->m_agent);
+        }
+        thread->m_state = FuriThreadStateStopped;
+    });
+}
+
+bool furi_thread_join(FuriThread* thread) {
+    furi_check(thread);
+    if(thread->m_thread.joinable()) {
+        thread->m_thread.join();
+    }
+    return true;
+}
+
+int32_t furi_thread_get_return_code(FuriThread* thread) {
+    furi_check(thread && thread->m_state == FuriThreadStateStopped);
+    return thread->m_return_code;
+}
+
+FuriThreadId furi_thread_get_current_id(void) {
+    thread_local char marker;
+    return &marker;
+}
+
+void furi_thread_yield(void) {
+    std::this_thread::yield();
+}
+}
@@ -0,0 +1,165 @@
+#include "kernel.hpp"
+
+#include <furi/core/check.h>
+#include <furi/core/common_defines.h>
+#include <furi/core/timer.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace cookie::host;
+
+struct FuriTimer {
+    FuriTimer(FuriTimerCallback callback, FuriTimerType type, void* context)
+        : m_callback(callback)
+        , m_context(context)
+        , m_type(type) {
+    }
+
+    FuriTimerCallback m_callback;
+    void* m_context;
+    FuriTimerType m_type;
+    uint32_t m_interval = 0;
+    uint64_t m_expiry = 0;
+    Kernel::Deadline m_deadline;
+    bool m_running = false;
+    bool m_in_callback = false;
+};
+
+namespace {
+
+// All Furi timers run their callbacks on a single thread, started with the first timer
+class TimerService {
+public:
+    static TimerService& get() {
+        static TimerService* service = nullptr;
+        if(!service) {
+            // The thread waits for the lock the caller holds before touching anything. It counts
+            // as busy from the start, so time stepped manually can't move past it before it runs.
+            service = new TimerService;
+            Kernel::get().add_agent(service->m_agent);
+            std::thread(&TimerService::run, service).detach();
+        }
+        return *service;
+    }
+
+    void add(FuriTimer* timer) {
+        m_timers.push_back(timer);
+    }
+
+    void remove(FuriTimer* timer) {
+        m_timers.erase(std::find(m_timers.begin(), m_timers.end(), timer));
+    }
+
+private:
+    void run() {
+        Kernel& kernel = Kernel::get();
+        auto lock = kernel.lock();
+        Kernel::set_current_agent(&m_agent);
+        for(;;) {
+            FuriTimer* expired = nullptr;
+            for(FuriTimer* timer : m_timers) {
+                if(timer->m_running && timer->m_expiry <= kernel.now() &&
+                   (!expired || timer->m_expiry < expired->m_expiry)) {
+                    expired = timer;
+                }
+            }
+            if(!expired) {
+                kernel.wait(lock, false);
+                continue;
+            }
+
+            kernel.remove_deadline(expired->m_deadline);
+            if(expired->m_type == FuriTimerTypePeriodic) {
+                expired->m_expiry += expired->m_interval;
+                expired->m_deadline = kernel.add_deadline(expired->m_expiry);
+            } else {
+                expired->m_running = false;
+            }
+
+            expired->m_in_callback = true;
+            lock.unlock();
+            expired->m_callback(expired->m_context);
+            lock.lock();
+            expired->m_in_callback = false;
+            kernel.notify();
+        }
+    }
+
+private:
+    std::vector<FuriTimer*> m_timers;
+    Agent m_agent;
+};
+
+void stop_locked(Kernel& kernel, FuriTimer* timer) {
+    if(timer->m_running) {
+        timer->m_running = false;
+        kernel.remove_deadline(timer->m_deadline);
+    }
+}
+
+}
+
+extern "C" {
+
+FuriTimer* furi_timer_alloc(FuriTimerCallback func, FuriTimerType type, void* context) {
+    furi_check(func);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    FuriTimer* timer = new FuriTimer(func, type, context);
+    TimerService::get().add(timer);
+    return timer;
+}
+
+void furi_timer_free(FuriTimer* instance) {
+    furi_check(instance);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    stop_locked(kernel, instance);
+    while(instance->m_in_callback) {
+        kernel.wait(lock);
+    }
+    TimerService::get().remove(instance);
+    delete instance;
+}
+
+FuriStatus furi_timer_start(FuriTimer* instance, uint32_t ticks) {
+    furi_check(instance);
+    furi_check(ticks > 0 && ticks < (1U << 31));
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    stop_locked(kernel, instance);
+    instance->m_interval = ticks;
+    instance->m_expiry = kernel.now() + ticks;
+    instance->m_deadline = kernel.add_deadline(instance->m_expiry);
+    instance->m_running = true;
+    kernel.notify();
+    return FuriStatusOk;
+}
+
+FuriStatus furi_timer_restart(FuriTimer* instance, uint32_t ticks) {
+    return furi_timer_start(instance, ticks);
+}
+
+FuriStatus furi_timer_stop(FuriTimer* instance) {
+    furi_check(instance);
+    Kernel& kernel = Kernel::get();
+    auto lock = kernel.lock();
+    stop_locked(kernel, instance);
+    kernel.notify();
+    return FuriStatusOk;
+}
+
+uint32_t furi_timer_is_running(FuriTimer* instance) {
+    furi_check(instance);
+    auto lock = Kernel::get().lock();
+    return instance->m_running;
+}
+
+uint32_t furi_timer_get_expire_time(FuriTimer* instance) {
+    furi_check(instance);
+    auto lock = Kernel::get().lock();
+    return static_cast<uint32_t>(instance->m_expiry);
+}
+}
@@ -0,0 +1,152 @@
+#include <furi/core/check.h>
+#include <furi/core/common_defines.h>
+#include <gui/view.h>
+
+#include <cstdlib>
+#include <mutex>
+
+struct View {
+    ViewModelType m_model_type = ViewModelTypeNone;
+    void* m_model = nullptr;
+    std::recursive_mutex m_model_mutex;
+
+    ViewDrawCallback m_draw_callback = nullptr;
+    ViewInputCallback m_input_callback = nullptr;
+    ViewCustomCallback m_custom_callback = nullptr;
+    ViewNavigationCallback m_previous_callback = nullptr;
+    ViewCallback m_enter_callback = nullptr;
+    ViewCallback m_exit_callback = nullptr;
+    void* m_context = nullptr;
+
+    ViewUpdateCallback m_update_callback = nullptr;
+    void* m_update_callback_context = nullptr;
+};
+
+extern "C" {
+
+View* view_alloc(void) {
+    return new View;
+}
+
+void view_free(View* view) {
+    furi_check(view);
+    view_free_model(view);
+    delete view;
+}
+
+void view_set_update_callback(View* view, ViewUpdateCallback callback) {
+    furi_check(view);
+    view->m_update_callback = callback;
+}
+
+void view_set_update_callback_context(View* view, void* context) {
+    furi_check(view);
+    view->m_update_callback_context = context;
+}
+
+void view_set_draw_callback(View* view, ViewDrawCallback callback) {
+    furi_check(view);
+    view->m_draw_callback = callback;
+}
+
+void view_set_input_callback(View* view, ViewInputCallback callback) {
+    furi_check(view);
+    view->m_input_callback = callback;
+}
+
+void view_set_custom_callback(View* view, ViewCustomCallback callback) {
+    furi_check(view);
+    view->m_custom_callback = callback;
+}
+
+void view_set_previous_callback(View* view, ViewNavigationCallback callback) {
+    furi_check(view);
+    view->m_previous_callback = callback;
+}
+
+void view_set_enter_callback(View* view, ViewCallback callback) {
+    furi_check(view);
+    view->m_enter_callback = callback;
+}
+
+void view_set_exit_callback(View* view, ViewCallback callback) {
+    furi_check(view);
+    view->m_exit_callback = callback;
+}
+
+void view_set_context(View* view, void* context) {
+    furi_check(view);
+    view->m_context = context;
+}
+
+void view_allocate_model(View* view, ViewModelType type, size_t size) {
+    furi_check(view && size > 0);
+    furi_check(view->m_model_type == ViewModelTypeNone && type != ViewModelTypeNone);
+    // Furi's malloc zeroes the memory, so do the same
+    view->m_model = std::calloc(1, size);
+    furi_check(view->m_model);
+    view->m_model_type = type;
+}
+
+void view_free_model(View* view) {
+    furi_check(view);
+    std::free(view->m_model);
+    view->m_model = nullptr;
+    view->m_model_type = ViewModelTypeNone;
+}
+
+void* view_get_model(View* view) {
+    furi_check(view);
+    if(view->m_model_type == ViewModelTypeLocking) {
+        view->m_model_mutex.lock();
+    }
+    return view->m_model;
+}
+
+void view_commit_model(View* view, bool update) {
+    furi_check(view);
+    if(view->m_model_type == ViewModelTypeLocking) {
+        view->m_model_mutex.unlock();
+    }
+    if(update && view->m_update_callback) {
+        view->m_update_callback(view, view->m_update_callback_context);
+    }
+}
+
+void view_draw(View* view, Canvas* canvas) {
+    furi_check(view);
+    if(!view->m_draw_callback) {
+        return;
+    }
+
+    void* model = view_get_model(view);
+    view->m_draw_callback(canvas, model);
+    if(view->m_model_type == ViewModelTypeLocking) {
+        view->m_model_mutex.unlock();
+    }
+}
+
+bool view_input(View* view, InputEvent* event) {
+    furi_check(view && event);
+    return view->m_input_callback ? view->m_input_callback(event, view->m_context) : false;
+}
+
+bool view_custom(View* view, uint32_t event) {
+    furi_check(view);
+    return view->m_custom_callback ? view->m_custom_callback(event, view->m_context) : false;
+}
+
+void view_enter(View* view) {
+    furi_check(view);
+    if(view->m_enter_callback) {
+        view->m_enter_callback(view->m_context);
+    }
+}
+
+void view_exit(View* view) {
+    furi_check(view);
+    if(view->m_exit_callback) {
+        view->m_exit_callback(view->m_context);
+    }
+}
+}
@@ -0,0 +1,64 @@
+#include "test.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace cookie::test {
+
+namespace {
+TestCase* g_tests = nullptr;
+TestCase** g_tests_tail = &g_tests;
+uint32_t g_failures = 0;
+}
+
+bool register_test(TestCase& test) {
+    // Keep the registration order, so tests run in the order they appear in each file
+    *g_tests_tail = &test;
+    g_tests_tail = &test.next;
+    return true;
+}
+
+void report_failure(const char* expression, const char* file, int line) {
+    std::printf("  %s:%d: %s failed\n", file, line, expression);
+    g_failures++;
+}
+
+}
+
+using namespace cookie::test;
+
+static bool is_selected(const TestCase& test, int argc, char** argv) {
+    if(argc < 2) {
+        return true;
+    }
+    for(int i = 1; i < argc; i++) {
+        if(std::strcmp(argv[i], test.name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    uint32_t run = 0, failed = 0;
+    for(TestCase* test = g_tests; test != nullptr; test = test->next) {
+        if(!is_selected(*test, argc, argv)) {
+            continue;
+        }
+
+        std::printf("[ RUN  ] %s\n", test->name);
+        std::fflush(stdout);
+        const uint32_t failures_before = g_failures;
+        test->func();
+        const bool ok = g_failures == failures_before;
+        std::printf("[ %s ] %s\n", ok ? " OK " : "FAIL", test->name);
+
+        run++;
+        if(!ok) {
+            failed++;
+        }
+    }
+
+    std::printf("%u tests run, %u failed\n", run, failed);
+    return run > 0 && failed == 0 ? 0 : 1;
+}
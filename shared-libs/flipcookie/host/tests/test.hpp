@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+// Minimal unit test harness. Tests register themselves at static initialization, and
+// flipcookie_tests runs all of them, or only those whose names are passed on the command line:
+//   TEST(frame_pool_exhaustion) {
+//       CHECK(pool.get_statistics().failed_allocations == 1);
+//   }
+// A failed CHECK reports itself and the test carries on, a failed REQUIRE ends the test.
+namespace cookie::test {
+
+struct TestCase {
+    const char* name;
+    void (*func)();
+    TestCase* next;
+};
+
+bool register_test(TestCase& test);
+void report_failure(const char* expression, const char* file, int line);
+
+}
+
+#define TEST(name)                                                               \
+    static void test_##name();                                                   \
+    static cookie::test::TestCase test_case_##name{#name, test_##name, nullptr}; \
+    [[maybe_unused]] static const bool test_registered_##name =                  \
+        cookie::test::register_test(test_case_##name);                           \
+    static void test_##name()
+
+#define CHECK(expr)                                                  \
+    do {                                                             \
+        if(!(expr)) {                                                \
+            cookie::test::report_failure(#expr, __FILE__, __LINE__); \
+        }                                                            \
+    } while(0)
+
+#define REQUIRE(expr)                                                \
+    do {                                                             \
+        if(!(expr)) {                                                \
+            cookie::test::report_failure(#expr, __FILE__, __LINE__); \
+            return;                                                  \
+        }                                                            \
+    } while(0)
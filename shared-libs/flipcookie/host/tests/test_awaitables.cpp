@@ -0,0 +1,275 @@
+// Awaitable semaphores, message queues and input: waking up, detaching from a destroyed task,
+// and several signals arriving before the waiting coroutine gets to run
+
+#include "test.hpp"
+
+#include <furi.h>
+
+#include <cookie/awaitables>
+#include <cookie/coroutine>
+#include <cookie/event_loop>
+#include <cookie/gui/input>
+
+#include <cstdint>
+#include <optional>
+
+namespace {
+
+// Runs the loop for a tick, so it gets to everything signalled so far
+void run_for_a_tick(FuriEventLoop* event_loop) {
+    cookie::FuriEventLoopTimer stop_timer(
+        event_loop,
+        [](void* context) { furi_event_loop_stop(reinterpret_cast<FuriEventLoop*>(context)); },
+        FuriEventLoopTimerTypeOnce,
+        event_loop);
+    furi_event_loop_timer_start(*stop_timer, 1);
+    furi_event_loop_run(event_loop);
+}
+
+using Queue = cookie::AwaitableMessageQueue<uint32_t>;
+
+InputEvent make_event(uint32_t sequence, InputKey key, InputType type) {
+    InputEvent event{};
+    event.sequence = sequence;
+    event.key = key;
+    event.type = type;
+    return event;
+}
+
+}
+
+TEST(awaitable_semaphore_wakes_on_release) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        cookie::AwaitableSemaphore semaphore(event_loop, 1, 0);
+        cookie::FuriEventLoopTimer release_timer(
+            event_loop,
+            [](void* context) {
+                reinterpret_cast<cookie::AwaitableSemaphore*>(context)->release();
+            },
+            FuriEventLoopTimerTypeOnce,
+            &semaphore);
+
+        const uint64_t start = furi_host_get_tick64();
+        uint64_t woken_at = 0;
+        auto wait = [&]() -> cookie::Task<> {
+            co_await semaphore.acquire();
+            woken_at = furi_host_get_tick64();
+            furi_event_loop_stop(event_loop);
+        };
+        cookie::Task<> task = wait();
+        CHECK(!task.has_finished());
+
+        furi_event_loop_timer_start(*release_timer, 100);
+        furi_event_loop_run(event_loop);
+
+        CHECK(task.has_finished());
+        CHECK(woken_at - start == 100);
+    }
+    furi_event_loop_free(event_loop);
+}
+
+TEST(awaitable_semaphore_detaches_when_the_task_is_destroyed) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        cookie::AwaitableSemaphore semaphore(event_loop, 1, 0);
+
+        uint32_t resumes = 0;
+        auto wait = [&]() -> cookie::Task<> {
+            co_await semaphore.acquire();
+            resumes++;
+        };
+        cookie::Task<> first = wait();
+        first.reset();
+
+        // Would trip the single waiter check if the destroyed task was still registered
+        cookie::Task<> second = wait();
+        CHECK(!second.has_finished());
+
+        semaphore.release();
+        run_for_a_tick(event_loop);
+        CHECK(second.has_finished());
+        CHECK(resumes == 1);
+    }
+    furi_event_loop_free(event_loop);
+}
+
+TEST(awaitable_semaphore_keeps_releases_made_before_the_resume) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        cookie::AwaitableSemaphore semaphore(event_loop, 3, 0);
+
+        uint32_t acquired = 0;
+        auto drain = [&]() -> cookie::Task<> {
+            for(;;) {
+                co_await semaphore.acquire();
+                acquired++;
+            }
+        };
+        cookie::Task<> task = drain();
+
+        // The edge triggered subscription calls back once for all three,
+        // the other two are taken by the next awaits without suspending
+        semaphore.release();
+        semaphore.release();
+        semaphore.release();
+        run_for_a_tick(event_loop);
+        CHECK(acquired == 3);
+
+        semaphore.release();
+        run_for_a_tick(event_loop);
+        CHECK(acquired == 4);
+    }
+    furi_event_loop_free(event_loop);
+}
+
+TEST(awaitable_message_queue_wakes_on_push) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        Queue queue(event_loop, 4);
+        cookie::FuriEventLoopTimer push_timer(
+            event_loop,
+            [](void* context) { reinterpret_cast<Queue*>(context)->push(42); },
+            FuriEventLoopTimerTypeOnce,
+            &queue);
+
+        const uint64_t start = furi_host_get_tick64();
+        uint64_t woken_at = 0;
+        auto wait = [&]() -> cookie::Task<uint32_t> {
+            const uint32_t message = co_await queue.pop();
+            woken_at = furi_host_get_tick64();
+            furi_event_loop_stop(event_loop);
+            co_return message;
+        };
+        cookie::Task<uint32_t> task = wait();
+        CHECK(!task.has_finished());
+
+        furi_event_loop_timer_start(*push_timer, 100);
+        furi_event_loop_run(event_loop);
+
+        CHECK(task.try_take_result() == 42U);
+        CHECK(woken_at - start == 100);
+    }
+    furi_event_loop_free(event_loop);
+}
+
+TEST(awaitable_message_queue_detaches_when_the_task_is_destroyed) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        Queue queue(event_loop, 4);
+
+        uint32_t resumes = 0;
+        auto wait = [&]() -> cookie::Task<uint32_t> {
+            const uint32_t message = co_await queue.pop();
+            resumes++;
+            co_return message;
+        };
+        cookie::Task<uint32_t> first = wait();
+        first.reset();
+
+        cookie::Task<uint32_t> second = wait();
+        CHECK(!second.has_finished());
+
+        // The message goes to the live task, not into the destroyed one's awaiter
+        queue.push(7);
+        run_for_a_tick(event_loop);
+        CHECK(second.try_take_result() == 7U);
+        CHECK(resumes == 1);
+    }
+    furi_event_loop_free(event_loop);
+}
+
+TEST(awaitable_message_queue_keeps_messages_pushed_before_the_resume) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        Queue queue(event_loop, 4);
+
+        uint32_t received[4] = {};
+        uint32_t count = 0;
+        auto drain = [&]() -> cookie::Task<> {
+            for(;;) {
+                received[count] = co_await queue.pop();
+                count++;
+            }
+        };
+        cookie::Task<> task = drain();
+
+        queue.push(1);
+        queue.push(2);
+        queue.push(3);
+        run_for_a_tick(event_loop);
+        CHECK(count == 3);
+
+        queue.push(4);
+        run_for_a_tick(event_loop);
+        CHECK(count == 4);
+        for(uint32_t i = 0; i < 4; i++) {
+            CHECK(received[i] == i + 1);
+        }
+    }
+    furi_event_loop_free(event_loop);
+}
+
+TEST(awaitable_input_wakes_on_a_matching_event) {
+    cookie::AwaitableInput input;
+
+    auto wait = [&]() -> cookie::Task<InputEvent> {
+        co_return co_await input.next(InputKeyOk, InputTypeShort);
+    };
+    cookie::Task<InputEvent> task = wait();
+
+    CHECK(!input.dispatch(make_event(1, InputKeyOk, InputTypePress)));
+    CHECK(!input.dispatch(make_event(2, InputKeyUp, InputTypeShort)));
+    CHECK(!task.has_finished());
+
+    CHECK(input.dispatch(make_event(3, InputKeyOk, InputTypeShort)));
+    const std::optional<InputEvent> event = task.try_take_result();
+    REQUIRE(event.has_value());
+    CHECK(event->sequence == 3);
+}
+
+TEST(awaitable_input_detaches_when_the_task_is_destroyed) {
+    cookie::AwaitableInput input;
+
+    uint32_t resumes = 0;
+    auto wait = [&]() -> cookie::Task<> {
+        co_await input.next();
+        resumes++;
+    };
+    cookie::Task<> first = wait();
+    first.reset();
+    CHECK(!input.dispatch(make_event(1, InputKeyOk, InputTypeShort)));
+
+    cookie::Task<> second = wait();
+    CHECK(input.dispatch(make_event(2, InputKeyOk, InputTypeShort)));
+    CHECK(second.has_finished());
+    CHECK(resumes == 1);
+}
+
+TEST(awaitable_input_delivers_each_event_once) {
+    cookie::AwaitableInput input;
+
+    // Input is not buffered, events arriving with nobody waiting are left to the caller
+    CHECK(!input.dispatch(make_event(1, InputKeyOk, InputTypePress)));
+    CHECK(!input.dispatch(make_event(2, InputKeyOk, InputTypeShort)));
+
+    // Awaiting again from inside dispatch() gets the next event, not the same one again
+    uint32_t sequences[3] = {};
+    uint32_t count = 0;
+    auto collect = [&]() -> cookie::Task<> {
+        while(count < 3) {
+            const InputEvent event = co_await input.next();
+            sequences[count++] = event.sequence;
+        }
+    };
+    cookie::Task<> task = collect();
+
+    for(uint32_t sequence = 3; sequence <= 5; sequence++) {
+        CHECK(input.dispatch(make_event(sequence, InputKeyOk, InputTypeShort)));
+    }
+    CHECK(!input.dispatch(make_event(6, InputKeyOk, InputTypeShort)));
+    CHECK(task.has_finished());
+    CHECK(sequences[0] == 3);
+    CHECK(sequences[1] == 4);
+    CHECK(sequences[2] == 5);
+}
@@ -0,0 +1,111 @@
+// Awaiting tasks, and the stack use of nested task chains
+
+#include "test.hpp"
+
+#include <cookie/coroutine>
+
+#include <algorithm>
+#include <coroutine>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+struct Suspend {
+    std::coroutine_handle<>* handle;
+
+    bool await_ready() const {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> h) {
+        *handle = h;
+    }
+
+    void await_resume() const {
+    }
+};
+
+// Lowest stack address seen while the chain unwinds
+uintptr_t g_stack_low;
+
+// Not inlined, so its local is on the stack of whoever calls it, even from a coroutine
+[[gnu::noinline]] void probe_stack() {
+    volatile char local;
+    g_stack_low = std::min(g_stack_low, reinterpret_cast<uintptr_t>(&local));
+}
+
+// Every level awaits the next one, the innermost suspends until resumed from outside
+cookie::Task<uint32_t> Chain(uint32_t depth, std::coroutine_handle<>* innermost) {
+    if(depth == 0) {
+        co_await Suspend{innermost};
+        probe_stack();
+        co_return 0;
+    }
+
+    const uint32_t result = co_await Chain(depth - 1, innermost);
+    probe_stack();
+    co_return result + 1;
+}
+
+// Resumes the handle from a known stack depth, and returns how deep the stack went below it
+[[gnu::noinline]] uintptr_t resume_and_measure_stack(std::coroutine_handle<> handle) {
+    volatile char local;
+    const uintptr_t top = reinterpret_cast<uintptr_t>(&local);
+    g_stack_low = top;
+    handle.resume();
+    return top - g_stack_low;
+}
+
+}
+
+TEST(coroutine_await_finished_task) {
+    auto immediate = []() -> cookie::Task<int> { co_return 42; };
+    auto parent = [&immediate]() -> cookie::Task<int> {
+        cookie::Task<int> child = immediate();
+        // Already finished, so this must not suspend
+        co_return co_await child + 1;
+    };
+
+    cookie::Task<int> task = parent();
+    CHECK(task.has_finished());
+    CHECK(task.try_take_result() == 43);
+}
+
+TEST(coroutine_await_multiple_results) {
+    std::coroutine_handle<> handle;
+    auto child = [&handle]() -> cookie::Task<int, bool> {
+        co_await Suspend{&handle};
+        co_return {7, true};
+    };
+    auto parent = [&child]() -> cookie::Task<int> {
+        auto [value, flag] = co_await child();
+        co_return flag ? value : -1;
+    };
+
+    cookie::Task<int> task = parent();
+    CHECK(task.is_running());
+    handle.resume();
+    CHECK(task.try_take_result() == 7);
+}
+
+TEST(coroutine_nested_chain_stack_is_bounded) {
+    // Without symmetric transfer, every finishing level would resume its parent from inside
+    // its own final suspend, and the stack would grow by a few frames per level
+    constexpr uint32_t DEPTHS[] = {1, 10, 1000, 5000};
+    constexpr uintptr_t STACK_BOUND = 1024;
+
+    for(uint32_t depth : DEPTHS) {
+        std::coroutine_handle<> innermost;
+        cookie::Task<uint32_t> chain = Chain(depth, &innermost);
+        REQUIRE(chain.is_running());
+
+        const uintptr_t stack_used = resume_and_measure_stack(innermost);
+        std::printf("  depth %u: %zu bytes of stack\n", depth, static_cast<size_t>(stack_used));
+        CHECK(chain.try_take_result() == depth);
+#ifndef __SANITIZE_ADDRESS__
+        // AddressSanitizer builds don't emit the tail calls symmetric transfer relies on
+        CHECK(stack_used < STACK_BOUND);
+#endif
+    }
+}
@@ -0,0 +1,105 @@
+// FramePool and PooledTask
+
+#include "test.hpp"
+
+#include <cookie/coroutine>
+#include <cookie/frame_pool>
+
+#include <coroutine>
+
+namespace {
+
+struct Suspend {
+    std::coroutine_handle<>* handle;
+
+    bool await_ready() const {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> h) {
+        *handle = h;
+    }
+
+    void await_resume() const {
+    }
+};
+
+cookie::FramePool<256, 2> g_exhaustion_pool;
+cookie::FramePool<256, 4> g_result_pool;
+cookie::FramePool<16, 1> g_tiny_pool;
+
+cookie::PooledTask<g_exhaustion_pool> Waiting(std::coroutine_handle<>* handle) {
+    co_await Suspend{handle};
+}
+
+cookie::PooledTask<g_result_pool, int> Doubled(int value) {
+    co_return value * 2;
+}
+
+cookie::PooledTask<g_tiny_pool> TooLarge() {
+    co_return;
+}
+
+}
+
+TEST(frame_pool_exhaustion) {
+    std::coroutine_handle<> first_handle, second_handle, third_handle;
+    auto first = Waiting(&first_handle);
+    auto second = Waiting(&second_handle);
+    CHECK(first.has_started());
+    CHECK(second.has_started());
+
+    // The pool is out of frames, the third task never gets created
+    auto third = Waiting(&third_handle);
+    CHECK(!third.has_started());
+    CHECK(!third.is_running());
+    CHECK(!third_handle);
+
+    auto stats = g_exhaustion_pool.get_statistics();
+    CHECK(stats.frames_in_use == 2);
+    CHECK(stats.peak_frames_in_use == 2);
+    CHECK(stats.failed_allocations == 1);
+
+    // A finished and destroyed task gives its frame back
+    first_handle.resume();
+    CHECK(first.has_finished());
+    first.reset();
+    stats = g_exhaustion_pool.get_statistics();
+    CHECK(stats.frames_in_use == 1);
+    CHECK(stats.peak_frames_in_use == 2);
+
+    third = Waiting(&third_handle);
+    CHECK(third.has_started());
+    stats = g_exhaustion_pool.get_statistics();
+    CHECK(stats.frames_in_use == 2);
+    CHECK(stats.peak_frames_in_use == 2);
+    CHECK(stats.failed_allocations == 1);
+
+    second.reset();
+    third.reset();
+    CHECK(g_exhaustion_pool.get_statistics().frames_in_use == 0);
+}
+
+TEST(frame_pool_frames_are_reused) {
+    for(int i = 0; i < 100; i++) {
+        auto task = Doubled(i);
+        REQUIRE(task.has_started());
+        CHECK(task.try_take_result() == i * 2);
+    }
+
+    // Every task was gone before the next one started
+    const auto stats = g_result_pool.get_statistics();
+    CHECK(stats.frames_in_use == 0);
+    CHECK(stats.peak_frames_in_use == 1);
+    CHECK(stats.failed_allocations == 0);
+}
+
+TEST(frame_pool_rejects_oversized_frames) {
+    auto task = TooLarge();
+    CHECK(!task.has_started());
+
+    const auto stats = g_tiny_pool.get_statistics();
+    CHECK(stats.frames_in_use == 0);
+    CHECK(stats.peak_frames_in_use == 0);
+    CHECK(stats.failed_allocations == 1);
+}
@@ -0,0 +1,173 @@
+// Generator and PooledGenerator
+
+#include "test.hpp"
+
+#include <cookie/coroutine>
+#include <cookie/frame_pool>
+#include <cookie/generator>
+
+#include <coroutine>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using IntGenerator = cookie::Generator<int>;
+
+// co_await in a generator body must not compile. The compiler goes through await_transform
+// whenever the promise declares one, so check that the generator's promise declares it and
+// that nothing can be passed to it. A promise without one would accept any co_await.
+struct AwaitTransformFallback {
+    void await_transform();
+};
+
+// Naming await_transform is ambiguous exactly when the promise declares one too
+template <typename Promise>
+struct AwaitTransformProbe : Promise, AwaitTransformFallback {};
+
+template <typename Promise>
+concept declares_await_transform = !requires { &AwaitTransformProbe<Promise>::await_transform; };
+
+template <typename Generator>
+concept rejects_co_await = declares_await_transform<typename Generator::promise_type> &&
+                           !requires(typename Generator::promise_type& promise) {
+                               promise.await_transform(std::suspend_never{});
+                           };
+
+template <typename Generator>
+concept accepts_co_yield = requires(
+    typename Generator::promise_type& promise, typename Generator::reference value) {
+    promise.yield_value(value);
+};
+
+static_assert(rejects_co_await<IntGenerator>);
+static_assert(rejects_co_await<cookie::Generator<int&>>);
+static_assert(accepts_co_yield<IntGenerator>);
+// Tasks have no await_transform and accept any awaitable, which the probe must tell apart
+static_assert(!declares_await_transform<cookie::Task<>::promise_type>);
+
+// Appends what the body does to the log, so the test can see how far it has run
+IntGenerator Logged(std::string* log) {
+    *log += "start,";
+    co_yield 1;
+    *log += "resumed,";
+    co_yield 2;
+    *log += "end,";
+}
+
+struct Guard {
+    uint32_t* destroyed;
+
+    ~Guard() {
+        (*destroyed)++;
+    }
+};
+
+IntGenerator Guarded(uint32_t* destroyed, bool* ran_past_first) {
+    Guard guard{destroyed};
+    co_yield 1;
+    *ran_past_first = true;
+    co_yield 2;
+}
+
+cookie::FramePool<16, 1> g_tiny_pool;
+cookie::FramePool<256, 1> g_single_pool;
+
+cookie::PooledGenerator<g_tiny_pool, int> TooLarge() {
+    co_yield 1;
+}
+
+cookie::PooledGenerator<g_single_pool, int> Counting(int count) {
+    for(int i = 0; i < count; i++) {
+        co_yield i;
+    }
+}
+
+}
+
+TEST(generator_runs_lazily_in_pull_order) {
+    std::string log;
+    IntGenerator generator = Logged(&log);
+    CHECK(generator.has_started());
+    CHECK(log.empty());
+
+    auto it = generator.begin();
+    CHECK(log == "start,");
+    REQUIRE(it != generator.end());
+    CHECK(*it == 1);
+
+    ++it;
+    CHECK(log == "start,resumed,");
+    REQUIRE(it != generator.end());
+    CHECK(*it == 2);
+
+    ++it;
+    CHECK(log == "start,resumed,end,");
+    CHECK(it == generator.end());
+}
+
+TEST(generator_destroyed_while_suspended) {
+    uint32_t destroyed = 0;
+    bool ran_past_first = false;
+    {
+        IntGenerator generator = Guarded(&destroyed, &ran_past_first);
+        auto it = generator.begin();
+        REQUIRE(it != generator.end());
+        CHECK(*it == 1);
+        CHECK(destroyed == 0);
+    }
+
+    // Destroying the generator unwinds the suspended body without running any more of it
+    CHECK(destroyed == 1);
+    CHECK(!ran_past_first);
+}
+
+TEST(generator_never_started_is_destroyed_cleanly) {
+    uint32_t destroyed = 0;
+    bool ran_past_first = false;
+    {
+        IntGenerator generator = Guarded(&destroyed, &ran_past_first);
+    }
+
+    // The body never ran, so the guard was never constructed
+    CHECK(destroyed == 0);
+    CHECK(!ran_past_first);
+}
+
+TEST(pooled_generator_allocation_failure) {
+    auto generator = TooLarge();
+    CHECK(!generator.has_started());
+
+    uint32_t values = 0;
+    for(int value : generator) {
+        (void)value;
+        values++;
+    }
+    CHECK(values == 0);
+    CHECK(g_tiny_pool.get_statistics().failed_allocations == 1);
+}
+
+TEST(pooled_generator_pool_exhaustion) {
+    {
+        auto first = Counting(3);
+        auto second = Counting(3);
+        CHECK(first.has_started());
+        CHECK(!second.has_started());
+
+        int sum = 0;
+        for(int value : first) {
+            sum += value;
+        }
+        CHECK(sum == 0 + 1 + 2);
+        CHECK(second.begin() == second.end());
+    }
+
+    // Both frames are back, or were never taken
+    const auto stats = g_single_pool.get_statistics();
+    CHECK(stats.frames_in_use == 0);
+    CHECK(stats.peak_frames_in_use == 1);
+    CHECK(stats.failed_allocations == 1);
+
+    auto third = Counting(1);
+    CHECK(third.has_started());
+}
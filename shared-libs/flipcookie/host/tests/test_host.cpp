@@ -0,0 +1,97 @@
+// The host emulation itself: virtual time, timers and threads
+
+#include "test.hpp"
+
+#include <furi.h>
+
+#include <cookie/coroutine>
+#include <cookie/event_loop>
+#include <cookie/semaphore>
+#include <cookie/thread>
+
+#include <atomic>
+
+TEST(host_time_skips_to_the_next_deadline) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        cookie::AwaitableTimer<cookie::FuriEventLoopTimer> timer(event_loop);
+
+        const uint64_t start = furi_host_get_tick64();
+        uint64_t woken_at = 0;
+        auto wait = [&]() -> cookie::Task<> {
+            // An hour of virtual time, which must pass without any real waiting
+            co_await timer.await_delay(60 * 60 * 1000);
+            woken_at = furi_host_get_tick64();
+            furi_event_loop_stop(event_loop);
+        };
+        cookie::Task<> task = wait();
+        furi_event_loop_run(event_loop);
+
+        CHECK(task.has_finished());
+        CHECK(woken_at - start == 60 * 60 * 1000);
+    }
+    furi_event_loop_free(event_loop);
+}
+
+TEST(host_manual_advance_fires_timers_in_order) {
+    furi_host_set_auto_advance(false);
+
+    struct Context {
+        std::atomic<uint32_t> fired{0};
+        std::atomic<uint32_t> order_errors{0};
+    } context;
+
+    auto callback = [](void* ctx) {
+        Context* context = reinterpret_cast<Context*>(ctx);
+        context->fired.fetch_add(1);
+    };
+    auto late_callback = [](void* ctx) {
+        Context* context = reinterpret_cast<Context*>(ctx);
+        // The earlier timer must have fired before this one
+        if(context->fired.fetch_add(1) != 1) {
+            context->order_errors.fetch_add(1);
+        }
+    };
+
+    FuriTimer* early = furi_timer_alloc(callback, FuriTimerTypeOnce, &context);
+    FuriTimer* late = furi_timer_alloc(late_callback, FuriTimerTypeOnce, &context);
+    furi_timer_start(late, 200);
+    furi_timer_start(early, 100);
+
+    furi_host_advance_ticks(99);
+    CHECK(context.fired == 0);
+    furi_host_advance_ticks(1);
+    CHECK(context.fired == 1);
+    furi_host_advance_ticks(100);
+    CHECK(context.fired == 2);
+    CHECK(context.order_errors == 0);
+
+    furi_timer_free(early);
+    furi_timer_free(late);
+    furi_host_set_auto_advance(true);
+}
+
+TEST(host_thread_delays_run_in_virtual_time) {
+    struct Context {
+        cookie::FuriBinarySemaphore done;
+        uint64_t elapsed = 0;
+    } context;
+
+    cookie::FuriThread thread(
+        "Delay",
+        1024,
+        [](void* ctx) -> int32_t {
+            Context* context = reinterpret_cast<Context*>(ctx);
+            const uint64_t start = furi_host_get_tick64();
+            furi_delay_ms(5000);
+            context->elapsed = furi_host_get_tick64() - start;
+            furi_semaphore_release(*context->done);
+            return 0;
+        },
+        &context);
+    furi_thread_start(*thread);
+
+    CHECK(furi_semaphore_acquire(*context.done, FuriWaitForever) == FuriStatusOk);
+    furi_thread_join(*thread);
+    CHECK(context.elapsed == 5000);
+}
@@ -0,0 +1,102 @@
+// SpscRing with the producer and the consumer on separate threads
+
+#include "test.hpp"
+
+#include <cookie/spsc_ring>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+constexpr uint32_t ITEM_COUNT = 200000;
+
+using Ring = cookie::SpscRing<uint32_t, 64>;
+
+struct Received {
+    uint32_t count = 0;
+    uint32_t out_of_order = 0;
+    uint32_t last = 0;
+
+    void add(uint32_t value) {
+        // Values are pushed in increasing order, and may only go missing through drops
+        if(count > 0 && value <= last) {
+            out_of_order++;
+        }
+        last = value;
+        count++;
+    }
+};
+
+// Alternates between both ways of consuming, until the producer is done and the ring is empty
+Received consume(Ring& ring, const std::atomic<bool>& producer_done) {
+    Received received;
+    for(uint32_t round = 0;; round++) {
+        const bool done = producer_done.load(std::memory_order_acquire);
+        if(round % 2 == 0) {
+            uint32_t value;
+            while(ring.pop(value)) {
+                received.add(value);
+            }
+        } else {
+            ring.consume_all([&received](const uint32_t* items, std::size_t count) {
+                for(std::size_t i = 0; i < count; i++) {
+                    received.add(items[i]);
+                }
+            });
+        }
+        if(done && ring.empty()) {
+            return received;
+        }
+        std::this_thread::yield();
+    }
+}
+
+}
+
+TEST(spsc_ring_drops_are_accounted_for) {
+    Ring ring;
+    std::atomic<bool> producer_done{false};
+    uint32_t failed_pushes = 0;
+
+    // Never waits for the consumer, so a full ring drops items
+    std::thread producer([&] {
+        for(uint32_t i = 0; i < ITEM_COUNT; i++) {
+            if(!ring.push(i)) {
+                failed_pushes++;
+            }
+        }
+        producer_done.store(true, std::memory_order_release);
+    });
+    const Received received = consume(ring, producer_done);
+    producer.join();
+
+    CHECK(received.out_of_order == 0);
+    CHECK(received.count + failed_pushes == ITEM_COUNT);
+    CHECK(ring.dropped() == failed_pushes);
+}
+
+TEST(spsc_ring_keeps_order_without_drops) {
+    Ring ring;
+    std::atomic<bool> producer_done{false};
+    uint32_t failed_pushes = 0;
+
+    // Retries until there's room, so every item makes it through
+    std::thread producer([&] {
+        for(uint32_t i = 0; i < ITEM_COUNT; i++) {
+            while(!ring.push(i)) {
+                failed_pushes++;
+                std::this_thread::yield();
+            }
+        }
+        producer_done.store(true, std::memory_order_release);
+    });
+    const Received received = consume(ring, producer_done);
+    producer.join();
+
+    CHECK(received.out_of_order == 0);
+    CHECK(received.count == ITEM_COUNT);
+    CHECK(received.last == ITEM_COUNT - 1);
+    CHECK(ring.dropped() == failed_pushes);
+}
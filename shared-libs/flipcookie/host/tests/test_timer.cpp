@@ -0,0 +1,103 @@
+// AwaitableTimer resuming through an EventLoopExecutor
+
+#include "test.hpp"
+
+#include <furi.h>
+
+#include <cookie/coroutine>
+#include <cookie/executor>
+#include <cookie/timer>
+
+#include <memory>
+
+namespace {
+
+using LoopTimer = cookie::AwaitableTimer<cookie::FuriTimer, cookie::EventLoopExecutor>;
+
+void stop_callback(void* context) {
+    furi_event_loop_stop(reinterpret_cast<FuriEventLoop*>(context));
+}
+
+}
+
+TEST(timer_event_loop_executor_resumes_on_the_loop) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        LoopTimer timer(cookie::EventLoopExecutor{event_loop});
+        const FuriThreadId loop_thread = furi_thread_get_current_id();
+
+        const uint64_t start = furi_host_get_tick64();
+        uint64_t woken_at = 0;
+        bool on_loop_thread = false;
+        auto wait = [&]() -> cookie::Task<bool> {
+            const bool timed_out = co_await timer.await_delay(100);
+            woken_at = furi_host_get_tick64();
+            on_loop_thread = furi_thread_get_current_id() == loop_thread;
+            furi_event_loop_stop(event_loop);
+            co_return timed_out;
+        };
+        cookie::Task<bool> task = wait();
+        furi_event_loop_run(event_loop);
+
+        CHECK(task.try_take_result() == true);
+        CHECK(woken_at - start == 100);
+        CHECK(on_loop_thread);
+    }
+    furi_event_loop_free(event_loop);
+}
+
+TEST(timer_destroyed_with_a_resume_queued) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        auto timer = std::make_unique<LoopTimer>(cookie::EventLoopExecutor{event_loop});
+
+        bool resumed = false;
+        auto wait = [&]() -> cookie::Task<> {
+            co_await timer->await_delay(1000);
+            resumed = true;
+        };
+        cookie::Task<> task = wait();
+
+        // The resumption is queued on the loop, then both the coroutine and the timer go away
+        // before the loop gets to it
+        timer->wake_up();
+        task.reset();
+        timer.reset();
+
+        furi_event_loop_pend_callback(event_loop, stop_callback, event_loop);
+        furi_event_loop_run(event_loop);
+        CHECK(!resumed);
+    }
+    furi_event_loop_free(event_loop);
+}
+
+TEST(timer_stale_resume_is_ignored) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        LoopTimer timer(cookie::EventLoopExecutor{event_loop});
+
+        auto first_wait = [&]() -> cookie::Task<> {
+            co_await timer.await_delay(1000);
+        };
+        cookie::Task<> first = first_wait();
+        timer.wake_up();
+        first.reset();
+        timer.reset();
+
+        // The resumption queued for the first wait must not cut the second one short
+        const uint64_t start = furi_host_get_tick64();
+        uint64_t woken_at = 0;
+        auto second_wait = [&]() -> cookie::Task<bool> {
+            const bool timed_out = co_await timer.await_delay(50);
+            woken_at = furi_host_get_tick64();
+            furi_event_loop_stop(event_loop);
+            co_return timed_out;
+        };
+        cookie::Task<bool> second = second_wait();
+        furi_event_loop_run(event_loop);
+
+        CHECK(second.try_take_result() == true);
+        CHECK(woken_at - start == 50);
+    }
+    furi_event_loop_free(event_loop);
+}
@@ -0,0 +1,155 @@
+// TimerWheel under thousands of randomly started, restarted and stopped timers
+
+#include "test.hpp"
+
+#include <furi.h>
+
+#include <cookie/timer_wheel>
+
+#include <cstdint>
+#include <deque>
+#include <random>
+
+namespace {
+
+constexpr uint32_t TIMER_COUNT = 5000;
+constexpr uint32_t MAX_INTERVAL = 3000;
+constexpr uint32_t MAX_STARTS = 4 * TIMER_COUNT;
+constexpr uint32_t RESOLUTION = 8;
+
+struct Stress;
+
+struct Probe {
+    Probe(Stress& stress, cookie::TimerWheel& wheel);
+
+    static void fire_callback(void* context);
+
+    Stress& stress;
+    cookie::TimerWheelTimer timer;
+    uint64_t deadline = 0;
+    bool armed = false;
+};
+
+struct Stress {
+    explicit Stress(FuriEventLoop* event_loop)
+        : event_loop(event_loop)
+        , first_tick(furi_get_tick()) {
+    }
+
+    FuriEventLoop* event_loop;
+    std::mt19937 random{20240613};
+    std::deque<Probe> probes;
+    uint32_t active = 0;
+    uint32_t starts = 0;
+    uint32_t fired = 0;
+    uint32_t early = 0;
+    uint32_t late = 0;
+    uint32_t stray = 0;
+    bool wrapped = false;
+    uint32_t first_tick;
+
+    uint32_t random_below(uint32_t bound) {
+        return std::uniform_int_distribution<uint32_t>(0, bound - 1)(random);
+    }
+
+    void start(Probe& probe) {
+        const uint32_t interval = 1 + random_below(MAX_INTERVAL);
+        probe.timer.start(interval);
+        probe.deadline = furi_host_get_tick64() + interval;
+        if(!probe.armed) {
+            probe.armed = true;
+            active++;
+        }
+        starts++;
+    }
+
+    void stop(Probe& probe) {
+        probe.timer.stop();
+        if(probe.armed) {
+            probe.armed = false;
+            active--;
+        }
+    }
+
+    void on_fired(Probe& probe) {
+        const uint64_t now = furi_host_get_tick64();
+        fired++;
+        if(!probe.armed) {
+            stray++;
+            return;
+        }
+        if(now < probe.deadline) {
+            early++;
+        } else if(now - probe.deadline > RESOLUTION) {
+            late++;
+        }
+        probe.armed = false;
+        active--;
+        if(furi_get_tick() < first_tick) {
+            wrapped = true;
+        }
+
+        // Keep the wheel busy: restart this timer, restart or stop another one
+        if(starts < MAX_STARTS) {
+            switch(random_below(4)) {
+            case 0:
+                start(probe);
+                break;
+            case 1:
+                start(probes[random_below(TIMER_COUNT)]);
+                break;
+            case 2:
+                stop(probes[random_below(TIMER_COUNT)]);
+                break;
+            default:
+                break;
+            }
+        }
+
+        if(active == 0) {
+            furi_event_loop_stop(event_loop);
+        }
+    }
+};
+
+Probe::Probe(Stress& stress, cookie::TimerWheel& wheel)
+    : stress(stress)
+    , timer(wheel, fire_callback, this) {
+}
+
+void Probe::fire_callback(void* context) {
+    Probe* probe = reinterpret_cast<Probe*>(context);
+    probe->stress.on_fired(*probe);
+}
+
+}
+
+TEST(timer_wheel_random_timers_across_tick_wrap) {
+    // Start shortly before the 32-bit tick wraps around, so most timers expire after it did
+    furi_host_advance_ticks(0U - furi_get_tick() - MAX_INTERVAL / 2);
+
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        cookie::TimerWheel wheel(event_loop, RESOLUTION);
+        Stress stress(event_loop);
+        for(uint32_t i = 0; i < TIMER_COUNT; i++) {
+            stress.probes.emplace_back(stress, wheel);
+        }
+        for(Probe& probe : stress.probes) {
+            stress.start(probe);
+        }
+
+        furi_event_loop_run(event_loop);
+
+        CHECK(stress.active == 0);
+        CHECK(stress.fired >= TIMER_COUNT);
+        CHECK(stress.early == 0);
+        CHECK(stress.late == 0);
+        CHECK(stress.stray == 0);
+        CHECK(stress.wrapped);
+        for(const Probe& probe : stress.probes) {
+            CHECK(!probe.timer.is_running());
+        }
+    }
+    furi_event_loop_free(event_loop);
+}
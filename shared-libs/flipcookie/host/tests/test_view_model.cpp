@@ -0,0 +1,171 @@
+// Seqlock view models read while another thread keeps updating them
+
+#include "test.hpp"
+
+#include <furi.h>
+
+#include <cookie/event_loop>
+#include <cookie/gui/view>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace {
+
+constexpr uint32_t WRITE_COUNT = 2000000;
+
+// Every update sets all the words to the same value, so a torn read has differing words
+struct Block {
+    using is_seqlock = void;
+
+    uint32_t words[16];
+};
+static_assert(sizeof(Block) == 64);
+
+struct Counter {
+    uint32_t value;
+};
+
+void count_update(View*, void* context) {
+    (*reinterpret_cast<uint32_t*>(context))++;
+}
+
+// Runs the loop for a tick, so it gets to everything requested so far
+void run_for_a_tick(FuriEventLoop* event_loop) {
+    cookie::FuriEventLoopTimer stop_timer(
+        event_loop,
+        [](void* context) { furi_event_loop_stop(reinterpret_cast<FuriEventLoop*>(context)); },
+        FuriEventLoopTimerTypeOnce,
+        event_loop);
+    furi_event_loop_timer_start(*stop_timer, 1);
+    furi_event_loop_run(event_loop);
+}
+
+struct Reads {
+    uint32_t count = 0;
+    uint32_t torn = 0;
+    uint32_t went_back = 0;
+    uint32_t last = 0;
+};
+
+}
+
+TEST(view_model_seqlock_reads_are_never_torn) {
+    cookie::ViewModel<Block> view;
+    Reads reads;
+
+    std::atomic<bool> writer_done{false};
+    std::thread writer([&] {
+        for(uint32_t i = 1; i <= WRITE_COUNT; i++) {
+            cookie::with_view_model(*view, [i](Block& block) {
+                for(uint32_t& word : block.words) {
+                    word = i;
+                }
+            });
+        }
+        writer_done.store(true, std::memory_order_release);
+    });
+
+    // Read the way a draw callback does, until the writer is done and the last update was seen
+    for(;;) {
+        const bool done = writer_done.load(std::memory_order_acquire);
+        void* model = view_get_model(*view);
+        const Block block = cookie::view_model_snapshot<Block>(model);
+        view_commit_model(*view, false);
+
+        reads.count++;
+        for(uint32_t word : block.words) {
+            if(word != block.words[0]) {
+                reads.torn++;
+                break;
+            }
+        }
+        if(block.words[0] < reads.last) {
+            reads.went_back++;
+        }
+        reads.last = block.words[0];
+
+        if(done) {
+            break;
+        }
+    }
+    writer.join();
+
+    CHECK(reads.count > 0);
+    CHECK(reads.torn == 0);
+    CHECK(reads.went_back == 0);
+    CHECK(reads.last == WRITE_COUNT);
+}
+
+TEST(view_model_seqlock_read_in_the_middle_of_a_write) {
+    // A reader preempting the writer halfway through an update, made deterministic
+    cookie::ViewModel<Block> view;
+    Block seen{};
+    cookie::with_view_model(*view, [&view, &seen](Block& block) {
+        for(uint32_t i = 0; i < 8; i++) {
+            block.words[i] = 1;
+        }
+        seen = cookie::view_model_snapshot<Block>(view_get_model(*view));
+        view_commit_model(*view, false);
+        for(uint32_t i = 8; i < 16; i++) {
+            block.words[i] = 1;
+        }
+    });
+
+    // The reader gets the previous contents, and the next one the finished update
+    for(uint32_t word : seen.words) {
+        CHECK(word == 0);
+    }
+    const Block after = cookie::view_model_snapshot<Block>(view_get_model(*view));
+    view_commit_model(*view, false);
+    for(uint32_t word : after.words) {
+        CHECK(word == 1);
+    }
+}
+
+TEST(redraw_coalescer_redraws_once_per_turn) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        cookie::ViewModel<Counter> view;
+        uint32_t redraws = 0;
+        view_set_update_callback(*view, count_update);
+        view_set_update_callback_context(*view, &redraws);
+
+        cookie::RedrawCoalescer coalescer(event_loop, *view);
+        for(uint32_t i = 0; i < 3; i++) {
+            cookie::with_view_model(coalescer, [](Counter& counter) { counter.value++; });
+        }
+        CHECK(redraws == 0);
+
+        run_for_a_tick(event_loop);
+        CHECK(redraws == 1);
+
+        const auto& stats = coalescer.get_statistics();
+        CHECK(stats.updates == 3);
+        CHECK(stats.changes == 3);
+        CHECK(stats.redraws == 1);
+    }
+    furi_event_loop_free(event_loop);
+}
+
+TEST(redraw_coalescer_destroyed_with_a_redraw_pending) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    {
+        cookie::ViewModel<Counter> view;
+        uint32_t redraws = 0;
+        view_set_update_callback(*view, count_update);
+        view_set_update_callback_context(*view, &redraws);
+
+        // Like an app updating its view in the last turn of its loop, then exiting
+        auto coalescer = std::make_unique<cookie::RedrawCoalescer>(event_loop, *view);
+        cookie::with_view_model(*coalescer, [](Counter& counter) { counter.value++; });
+        coalescer.reset();
+
+        run_for_a_tick(event_loop);
+        CHECK(redraws == 0);
+    }
+    // Would fail if the coalescer left its subscription behind
+    furi_event_loop_free(event_loop);
+}
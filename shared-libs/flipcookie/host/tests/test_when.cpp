@@ -0,0 +1,180 @@
+// when_all and when_any: cancellation of the losers, immediate completion, resuming the parent
+
+#include "test.hpp"
+
+#include <cookie/coroutine>
+#include <cookie/when>
+
+#include <coroutine>
+#include <utility>
+
+namespace {
+
+// One-shot event carrying a value. Like the library's awaiters, a destroyed awaiter
+// detaches itself, so a firing event never resumes a dead frame.
+class Event {
+public:
+    auto wait() {
+        struct Awaiter {
+            Event* m_event;
+            std::coroutine_handle<> m_handle;
+
+            ~Awaiter() {
+                if(m_handle && m_event->m_waiter == m_handle) {
+                    m_event->m_waiter = nullptr;
+                }
+            }
+
+            bool await_ready() const {
+                return m_event->m_fired;
+            }
+
+            void await_suspend(std::coroutine_handle<> h) {
+                m_handle = h;
+                m_event->m_waiter = h;
+            }
+
+            int await_resume() {
+                m_handle = nullptr;
+                return m_event->m_value;
+            }
+        };
+        return Awaiter{this, nullptr};
+    }
+
+    void fire(int value) {
+        m_fired = true;
+        m_value = value;
+        if(std::coroutine_handle<> waiter = std::exchange(m_waiter, nullptr)) {
+            waiter.resume();
+        }
+    }
+
+    bool has_waiter() const {
+        return static_cast<bool>(m_waiter);
+    }
+
+private:
+    std::coroutine_handle<> m_waiter;
+    bool m_fired = false;
+    int m_value = 0;
+};
+
+cookie::Task<int> Forward(Event& event) {
+    co_return co_await event.wait();
+}
+
+}
+
+TEST(when_any_first_wins_and_losers_detach) {
+    Event first, second;
+    uint32_t resumes = 0;
+    bool second_armed = true;
+    auto parent = [&]() -> cookie::Task<int> {
+        // Passed as an lvalue, the awaiter is only referenced by the combinator,
+        // and outlives it
+        auto second_awaiter = second.wait();
+        auto result = co_await cookie::when_any(first.wait(), second_awaiter);
+        resumes++;
+        // The losing helper was destroyed together with the awaiter it was suspended on
+        second_armed = second.has_waiter();
+        co_return result.index() == 0 ? std::get<0>(result) : -1;
+    };
+
+    cookie::Task<int> task = parent();
+    CHECK(first.has_waiter());
+    CHECK(second.has_waiter());
+
+    first.fire(5);
+    CHECK(task.try_take_result() == 5);
+    CHECK(resumes == 1);
+    CHECK(!second_armed);
+
+    // Nothing is left waiting, so this must not resume anything
+    second.fire(6);
+    CHECK(resumes == 1);
+}
+
+TEST(when_any_losing_task_keeps_running_detached) {
+    Event first, second;
+    uint32_t resumes = 0;
+    cookie::Task<int> child = Forward(second);
+    auto parent = [&]() -> cookie::Task<int> {
+        auto result = co_await cookie::when_any(first.wait(), child);
+        resumes++;
+        co_return static_cast<int>(result.index());
+    };
+
+    cookie::Task<int> task = parent();
+    first.fire(1);
+    CHECK(task.try_take_result() == 0);
+    CHECK(resumes == 1);
+
+    // The child outlives the combinator, and finishes without resuming anyone
+    CHECK(child.is_running());
+    second.fire(2);
+    CHECK(child.try_take_result() == 2);
+    CHECK(resumes == 1);
+}
+
+TEST(when_any_immediate_completion) {
+    Event ready, pending;
+    ready.fire(3);
+
+    auto parent = [&]() -> cookie::Task<int> {
+        auto result = co_await cookie::when_any(ready.wait(), pending.wait());
+        co_return result.index() == 0 ? std::get<0>(result) : -1;
+    };
+
+    // Finished without suspending, and the awaitables after the winner were never started
+    cookie::Task<int> task = parent();
+    CHECK(task.try_take_result() == 3);
+    CHECK(!pending.has_waiter());
+}
+
+TEST(when_all_resumes_the_parent_once) {
+    Event first, second;
+    uint32_t resumes = 0;
+    auto parent = [&]() -> cookie::Task<int> {
+        auto second_awaiter = second.wait();
+        auto [a, b] = co_await cookie::when_all(first.wait(), second_awaiter);
+        resumes++;
+        co_return a * 10 + b;
+    };
+
+    cookie::Task<int> task = parent();
+    second.fire(2);
+    CHECK(task.is_running());
+    CHECK(resumes == 0);
+
+    first.fire(1);
+    CHECK(task.try_take_result() == 12);
+    CHECK(resumes == 1);
+}
+
+TEST(when_all_immediate_completion) {
+    Event first, second;
+    first.fire(4);
+    second.fire(5);
+
+    auto parent = [&]() -> cookie::Task<int> {
+        auto [a, b] = co_await cookie::when_all(first.wait(), Forward(second));
+        co_return a + b;
+    };
+
+    cookie::Task<int> task = parent();
+    CHECK(task.try_take_result() == 9);
+}
+
+TEST(when_all_destroyed_while_waiting_detaches_all) {
+    Event first, second;
+    {
+        auto parent = [&]() -> cookie::Task<> {
+            co_await cookie::when_all(first.wait(), second.wait());
+        };
+        cookie::Task<> task = parent();
+        first.fire(1);
+        CHECK(second.has_waiter());
+    }
+    CHECK(!second.has_waiter());
+}